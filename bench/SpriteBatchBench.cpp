@@ -0,0 +1,612 @@
+// SpriteBatchBench.cpp
+
+// SAGE Includes
+#include <SAGE/AllocationCounter.hpp>
+#include <SAGE/GeometryBatch.hpp>
+#include <SAGE/IFont.hpp>
+#include <SAGE/RecordingRenderDevice.hpp>
+#include <SAGE/SpriteBatch.hpp>
+// STL Includes
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace SAGE;
+
+namespace
+{
+	const int SpriteCounts[] = { 100, 1000, 10000, 100000 };
+	const int WarmupIterations = 2;
+	const int MinimumIterations = 5;
+	const int SpritesPerCase = 2000000;
+	const int TextureCount = 4;
+	const int StringLength = 10;
+	const unsigned int Seed = 1234567;
+	const int AllocationCheckCount = 1000;
+	const int AllocationCheckFrames = 10;
+	const int LineLoopLength = 8;
+	// Not a multiple of four, so the scalar tail after the wide path is compared too.
+	const int EquivalenceCheckCount = 1003;
+
+	// Fixed-width 8x8 glyphs on a 16x16 grid, so DrawString has something to lay out without SDL_ttf.
+	class BenchFont : public IFont
+	{
+		public:
+			bool Initialize()
+			{
+				std::vector<Color> pixels(128 * 128, Color::White);
+
+				return m_Texture.FromPixelColors(128, 128, pixels);
+			}
+
+			float GetCharacterSpacing(Uint16 p_Character) const override
+			{
+				return 8.0f;
+			}
+
+			float GetLineSpacing() const override
+			{
+				return 10.0f;
+			}
+
+			const Texture& GetTexture() const override
+			{
+				return m_Texture;
+			}
+
+			Rectangle GetCharacterBounds(Uint16 p_Character) const override
+			{
+				return Rectangle((p_Character % 16) * 8, ((p_Character / 16) % 16) * 8, 8, 8);
+			}
+
+			void MeasureString(const std::string& p_String, Vector2& p_Dimensions) override
+			{
+				p_Dimensions = Vector2(p_String.size() * 8.0f, 8.0f);
+			}
+
+		private:
+			Texture m_Texture;
+	};
+
+	enum class BenchPrimitive
+	{
+		Sprite,
+		SpriteOneTexture,
+		Sprites,
+		String,
+		Line,
+	};
+
+	struct BenchCase
+	{
+		const char* Name;
+		BenchPrimitive Primitive;
+		SortMode Sorting;
+	};
+
+	struct BenchResult
+	{
+		const BenchCase* Case;
+		int SpriteCount;
+		int Iterations;
+		double RecordNanoseconds;
+		double EndNanoseconds;
+		double UploadedBytes;
+		int DrawCalls;
+	};
+
+	// Everything drawn in a frame, generated once per count from a fixed seed.
+	struct BenchScene
+	{
+		std::vector<float> PositionX;
+		std::vector<float> PositionY;
+		std::vector<float> Rotation;
+		std::vector<float> Depth;
+		std::vector<int> TextureIndex;
+		std::vector<std::string> Strings;
+	};
+
+	const BenchCase Cases[] =
+	{
+		{ "DrawSprite", BenchPrimitive::Sprite, SortMode::None },
+		{ "DrawSprite", BenchPrimitive::Sprite, SortMode::FrontToBack },
+		{ "DrawSprite", BenchPrimitive::Sprite, SortMode::BackToFront },
+		{ "DrawSprite", BenchPrimitive::Sprite, SortMode::Texture },
+		{ "DrawSprite", BenchPrimitive::Sprite, SortMode::Immediate },
+		// Same texture and arrays as DrawSprites, so the two differ only in the scalar and SIMD paths.
+		{ "DrawSpriteOneTexture", BenchPrimitive::SpriteOneTexture, SortMode::None },
+		{ "DrawSprites", BenchPrimitive::Sprites, SortMode::None },
+		{ "DrawString", BenchPrimitive::String, SortMode::None },
+		{ "DrawLine", BenchPrimitive::Line, SortMode::None },
+	};
+
+	const char* GetSortModeName(SortMode p_SortMode)
+	{
+		switch (p_SortMode)
+		{
+			case SortMode::None:
+				return "None";
+			case SortMode::FrontToBack:
+				return "FrontToBack";
+			case SortMode::BackToFront:
+				return "BackToFront";
+			case SortMode::Texture:
+				return "Texture";
+			case SortMode::Immediate:
+				return "Immediate";
+		}
+
+		return "Unknown";
+	}
+
+	double GetNanoseconds(Uint64 p_Start, Uint64 p_End)
+	{
+		return static_cast<double>(p_End - p_Start) * 1000000000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	}
+
+	double GetMedian(std::vector<double>& p_Values)
+	{
+		std::sort(p_Values.begin(), p_Values.end());
+
+		return p_Values[p_Values.size() / 2];
+	}
+
+	void CreateScene(BenchScene& p_Scene, int p_Count)
+	{
+		std::mt19937 generator(Seed);
+		std::uniform_real_distribution<float> position(0.0f, 1280.0f);
+		std::uniform_real_distribution<float> rotation(0.0f, 6.2831853f);
+		std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+		std::uniform_int_distribution<int> texture(0, TextureCount - 1);
+		std::uniform_int_distribution<int> character(32, 126);
+
+		p_Scene.PositionX.resize(p_Count);
+		p_Scene.PositionY.resize(p_Count);
+		p_Scene.Rotation.resize(p_Count);
+		p_Scene.Depth.resize(p_Count);
+		p_Scene.TextureIndex.resize(p_Count);
+
+		for (int i = 0; i < p_Count; ++i)
+		{
+			p_Scene.PositionX[i] = position(generator);
+			p_Scene.PositionY[i] = position(generator);
+			p_Scene.Rotation[i] = rotation(generator);
+			p_Scene.Depth[i] = depth(generator);
+			p_Scene.TextureIndex[i] = texture(generator);
+		}
+
+		// One glyph counts as one sprite.
+		p_Scene.Strings.resize(std::max(1, p_Count / StringLength));
+		for (std::string& text : p_Scene.Strings)
+		{
+			text.resize(StringLength);
+			for (char& ch : text)
+			{
+				ch = static_cast<char>(character(generator));
+			}
+		}
+	}
+
+	void Record(SpriteBatch& p_Batch, const BenchCase& p_Case, const BenchScene& p_Scene, const std::vector<Texture>& p_Textures, BenchFont& p_Font)
+	{
+		int count = static_cast<int>(p_Scene.PositionX.size());
+
+		switch (p_Case.Primitive)
+		{
+			case BenchPrimitive::Sprite:
+				for (int i = 0; i < count; ++i)
+				{
+					p_Batch.DrawSprite(p_Textures[p_Scene.TextureIndex[i]], Vector2(p_Scene.PositionX[i], p_Scene.PositionY[i]), Rectangle::Empty, Color::White, Vector2::Zero, p_Scene.Rotation[i], Vector2::One, Orientation::None, p_Scene.Depth[i]);
+				}
+				break;
+			case BenchPrimitive::SpriteOneTexture:
+				for (int i = 0; i < count; ++i)
+				{
+					p_Batch.DrawSprite(p_Textures[0], Vector2(p_Scene.PositionX[i], p_Scene.PositionY[i]), Rectangle::Empty, Color::White, Vector2::Zero, p_Scene.Rotation[i], Vector2::One, Orientation::None, p_Scene.Depth[i]);
+				}
+				break;
+			case BenchPrimitive::Sprites:
+			{
+				SpriteDescriptors sprites;
+				sprites.Count = count;
+				sprites.PositionX = &p_Scene.PositionX.front();
+				sprites.PositionY = &p_Scene.PositionY.front();
+				sprites.Rotation = &p_Scene.Rotation.front();
+				sprites.Depth = &p_Scene.Depth.front();
+
+				p_Batch.DrawSprites(p_Textures[0], sprites);
+				break;
+			}
+			case BenchPrimitive::String:
+				for (size_t i = 0; i < p_Scene.Strings.size(); ++i)
+				{
+					p_Batch.DrawString(&p_Font, p_Scene.Strings[i], Vector2(p_Scene.PositionX[i], p_Scene.PositionY[i]), Color::White, p_Scene.Depth[i]);
+				}
+				break;
+			case BenchPrimitive::Line:
+				for (int i = 0; i + 1 < count; i += 2)
+				{
+					p_Batch.DrawLine(Vector2(p_Scene.PositionX[i], p_Scene.PositionY[i]), Vector2(p_Scene.PositionX[i + 1], p_Scene.PositionY[i + 1]), Color::White, 1.0f, p_Scene.Depth[i]);
+					p_Batch.DrawLine(Vector2(p_Scene.PositionX[i + 1], p_Scene.PositionY[i + 1]), Vector2(p_Scene.PositionX[i], p_Scene.PositionY[i]), Color::White, 1.0f, p_Scene.Depth[i + 1]);
+				}
+				break;
+		}
+	}
+
+	BenchResult Run(const BenchCase& p_Case, int p_Count, RecordingRenderDevice& p_Device, SpriteBatch& p_Batch, Effect& p_Effect, const std::vector<Texture>& p_Textures, BenchFont& p_Font)
+	{
+		BenchScene scene;
+		CreateScene(scene, p_Count);
+
+		BenchResult result;
+		result.Case = &p_Case;
+		result.SpriteCount = p_Count;
+		result.Iterations = std::max(MinimumIterations, SpritesPerCase / p_Count);
+
+		std::vector<double> recordTimes;
+		std::vector<double> endTimes;
+
+		for (int i = -WarmupIterations; i < result.Iterations; ++i)
+		{
+			p_Device.ClearCommands();
+
+			Uint64 start = SDL_GetPerformanceCounter();
+			p_Batch.Begin(p_Effect, Camera2D::DefaultCamera, p_Case.Sorting, BlendMode::AlphaBlended);
+			Record(p_Batch, p_Case, scene, p_Textures, p_Font);
+			Uint64 recorded = SDL_GetPerformanceCounter();
+			p_Batch.End();
+			Uint64 end = SDL_GetPerformanceCounter();
+
+			if (i < 0)
+				continue;
+
+			recordTimes.push_back(GetNanoseconds(start, recorded));
+			endTimes.push_back(GetNanoseconds(recorded, end));
+
+			result.UploadedBytes = p_Batch.GetUploadedByteCount();
+			result.DrawCalls = p_Device.GetDrawCallCount();
+		}
+
+		result.RecordNanoseconds = GetMedian(recordTimes);
+		result.EndNanoseconds = GetMedian(endTimes);
+
+		return result;
+	}
+
+	// Records circles, lines and line loops through both batches for a warm-up frame that sizes every
+	// buffer, then counts heap allocations over the frames after it. Any allocation at all fails the check.
+	int CheckAllocations(RecordingRenderDevice& p_Device, SpriteBatch& p_Batch, Effect& p_Effect, GeometryBatch& p_GeometryBatch, Effect& p_GeometryEffect)
+	{
+		BenchScene scene;
+		CreateScene(scene, AllocationCheckCount);
+
+		std::vector<Vector2> positions(AllocationCheckCount);
+		std::vector<VertexPositionColor> lineVertices(AllocationCheckCount);
+		for (int i = 0; i < AllocationCheckCount; ++i)
+		{
+			positions[i] = Vector2(scene.PositionX[i], scene.PositionY[i]);
+
+			VertexPositionColor& vertex = lineVertices[i];
+			vertex.Position.X = scene.PositionX[i];
+			vertex.Position.Y = scene.PositionY[i];
+			vertex.Color.R = Color::White.GetRed();
+			vertex.Color.G = Color::White.GetGreen();
+			vertex.Color.B = Color::White.GetBlue();
+			vertex.Color.A = Color::White.GetAlpha();
+		}
+
+		UnitCircle circle(48);
+
+		long long allocations = 0;
+		for (int frame = 0; frame <= AllocationCheckFrames; ++frame)
+		{
+			if (frame == 1)
+				AllocationCounter::Reset();
+
+			p_Device.ClearCommands();
+
+			p_Batch.Begin(p_Effect, Camera2D::DefaultCamera, SortMode::None, BlendMode::AlphaBlended);
+
+			for (int i = 0; i < AllocationCheckCount; ++i)
+			{
+				p_Batch.DrawCircle(positions[i], Color::White, 16.0f, 1.0f, scene.Depth[i]);
+			}
+
+			for (int i = 0; i + 1 < AllocationCheckCount; i += 2)
+			{
+				p_Batch.DrawLine(positions[i], positions[i + 1], Color::White, 1.0f, scene.Depth[i]);
+			}
+
+			p_Batch.DrawLines(&positions.front(), AllocationCheckCount, &Color::White, 1);
+
+			for (int i = 0; i + LineLoopLength <= AllocationCheckCount; i += LineLoopLength)
+			{
+				p_Batch.DrawLineLoop(&positions[i], LineLoopLength, &Color::White, 1);
+			}
+
+			p_Batch.End();
+			p_Batch.EndFrame();
+
+			p_GeometryBatch.Begin(p_GeometryEffect);
+
+			for (int i = 0; i < AllocationCheckCount; ++i)
+			{
+				p_GeometryBatch.DrawCircle(positions[i], 16.0f, Color::White);
+				p_GeometryBatch.DrawCircle(positions[i], 8.0f, Color::White, circle);
+			}
+
+			for (int i = 0; i + 1 < AllocationCheckCount; i += 2)
+			{
+				p_GeometryBatch.DrawLine(positions[i], positions[i + 1], Color::White);
+			}
+
+			p_GeometryBatch.DrawLineList(&lineVertices.front(), AllocationCheckCount);
+
+			p_GeometryBatch.End();
+
+			if (frame > 0)
+			{
+				long long total = AllocationCounter::GetAllocationCount();
+				if (total != allocations)
+					fprintf(stderr, "Frame %d made %lld heap allocations.\n", frame, total - allocations);
+
+				allocations = total;
+			}
+		}
+
+		fprintf(stderr, "Allocation check: %lld heap allocations over %d frames after warm-up.\n", allocations, AllocationCheckFrames);
+
+		return allocations == 0 ? 0 : 1;
+	}
+
+	// Copies out the vertices the last draw pair uploaded. Dynamic batches upload each render from offset zero.
+	std::vector<unsigned char> GetUploadedVertices(const RecordingRenderDevice& p_Device)
+	{
+		const std::vector<RenderCommand>& commands = p_Device.GetCommands();
+		for (auto iterator = commands.rbegin(); iterator != commands.rend(); ++iterator)
+		{
+			if (iterator->Type == RenderCommandType::BufferSubData && iterator->Target == GL_ARRAY_BUFFER)
+			{
+				const std::vector<unsigned char>& contents = p_Device.GetBufferContents(iterator->Object);
+				size_t size = static_cast<size_t>(iterator->Arguments[1]);
+
+				return std::vector<unsigned char>(contents.begin(), contents.begin() + std::min(size, contents.size()));
+			}
+		}
+
+		return std::vector<unsigned char>();
+	}
+
+	// Records the same sprites through DrawSprites and through a DrawSprite loop, with every optional
+	// array set, and compares the uploaded vertices byte for byte. Any difference fails the check.
+	int CheckSpritesMatchScalar(RecordingRenderDevice& p_Device, Effect& p_Effect, const Texture& p_Texture)
+	{
+		SpriteBatchOptions options;
+		options.Buffering = BufferMode::Dynamic;
+
+		SpriteBatch batch;
+		if (!batch.Initialize(options))
+		{
+			SDL_Log("[SpriteBatchBench] Failed to initialize the equivalence check sprite batch.");
+			return 1;
+		}
+
+		BenchScene scene;
+		CreateScene(scene, EquivalenceCheckCount);
+
+		std::mt19937 generator(Seed);
+		std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+		std::uniform_real_distribution<float> origin(0.0f, 32.0f);
+		std::uniform_int_distribution<int> corner(0, 31);
+		std::uniform_int_distribution<int> channel(0, 255);
+
+		const Orientation orientations[] = { Orientation::None, Orientation::FlipHorizontal, Orientation::FlipVertical, Orientation::FlipBoth };
+
+		std::vector<float> scaleX(EquivalenceCheckCount), scaleY(EquivalenceCheckCount);
+		std::vector<float> originX(EquivalenceCheckCount), originY(EquivalenceCheckCount);
+		std::vector<Rectangle> sourceRectangles(EquivalenceCheckCount);
+		std::vector<Color> colors(EquivalenceCheckCount);
+		std::vector<Orientation> flips(EquivalenceCheckCount);
+
+		for (int i = 0; i < EquivalenceCheckCount; ++i)
+		{
+			scaleX[i] = scale(generator);
+			scaleY[i] = scale(generator);
+			originX[i] = origin(generator);
+			originY[i] = origin(generator);
+
+			// Mix whole-texture sprites, sub-rectangles and unrotated sprites into every group of four.
+			if (i % 3 != 0)
+				sourceRectangles[i] = Rectangle(corner(generator), corner(generator), 1 + corner(generator), 1 + corner(generator));
+			else
+				sourceRectangles[i] = Rectangle::Empty;
+
+			if (i % 5 == 0)
+				scene.Rotation[i] = 0.0f;
+
+			colors[i] = Color(channel(generator), channel(generator), channel(generator), channel(generator));
+			flips[i] = orientations[i % 4];
+		}
+
+		SpriteDescriptors sprites;
+		sprites.Count = EquivalenceCheckCount;
+		sprites.PositionX = &scene.PositionX.front();
+		sprites.PositionY = &scene.PositionY.front();
+		sprites.ScaleX = &scaleX.front();
+		sprites.ScaleY = &scaleY.front();
+		sprites.OriginX = &originX.front();
+		sprites.OriginY = &originY.front();
+		sprites.Rotation = &scene.Rotation.front();
+		sprites.Depth = &scene.Depth.front();
+		sprites.SourceRectangles = &sourceRectangles.front();
+		sprites.Colors = &colors.front();
+		sprites.Orientations = &flips.front();
+
+		p_Device.ClearCommands();
+		batch.Begin(p_Effect, Camera2D::DefaultCamera, SortMode::None, BlendMode::AlphaBlended);
+		batch.DrawSprites(p_Texture, sprites);
+		batch.End();
+		batch.EndFrame();
+
+		std::vector<unsigned char> bulk = GetUploadedVertices(p_Device);
+
+		p_Device.ClearCommands();
+		batch.Begin(p_Effect, Camera2D::DefaultCamera, SortMode::None, BlendMode::AlphaBlended);
+		for (int i = 0; i < EquivalenceCheckCount; ++i)
+		{
+			batch.DrawSprite(p_Texture, Vector2(scene.PositionX[i], scene.PositionY[i]), sourceRectangles[i], colors[i], Vector2(originX[i], originY[i]), scene.Rotation[i], Vector2(scaleX[i], scaleY[i]), flips[i], scene.Depth[i]);
+		}
+		batch.End();
+		batch.EndFrame();
+
+		std::vector<unsigned char> scalar = GetUploadedVertices(p_Device);
+
+		p_Device.ClearCommands();
+
+		if (scalar.empty() || bulk.size() != scalar.size())
+		{
+			fprintf(stderr, "Equivalence check: DrawSprites uploaded %d bytes, DrawSprite %d bytes.\n", static_cast<int>(bulk.size()), static_cast<int>(scalar.size()));
+			return 1;
+		}
+
+		auto mismatch = std::mismatch(bulk.begin(), bulk.end(), scalar.begin());
+		if (mismatch.first != bulk.end())
+		{
+			int offset = static_cast<int>(mismatch.first - bulk.begin());
+			fprintf(stderr, "Equivalence check: DrawSprites differs from DrawSprite at byte %d (sprite %d).\n", offset, offset / static_cast<int>(4 * sizeof(VertexPositionColorTexture)));
+			return 1;
+		}
+
+		fprintf(stderr, "Equivalence check: DrawSprites matches DrawSprite over %d sprites.\n", EquivalenceCheckCount);
+
+		return 0;
+	}
+
+	void WriteResults(FILE* p_File, const std::vector<BenchResult>& p_Results)
+	{
+		fprintf(p_File, "{\n\t\"benchmark\": \"SpriteBatch\",\n\t\"results\": [\n");
+
+		for (size_t i = 0; i < p_Results.size(); ++i)
+		{
+			const BenchResult& result = p_Results[i];
+			double sprites = static_cast<double>(result.SpriteCount);
+
+			fprintf(p_File, "\t\t{ \"case\": \"%s\", \"sort\": \"%s\", \"sprites\": %d, \"iterations\": %d, \"record_ns_per_sprite\": %.3f, \"end_ns_per_sprite\": %.3f, \"total_ns_per_sprite\": %.3f, \"bytes_per_sprite\": %.2f, \"draw_calls\": %d }%s\n",
+					result.Case->Name,
+					GetSortModeName(result.Case->Sorting),
+					result.SpriteCount,
+					result.Iterations,
+					result.RecordNanoseconds / sprites,
+					result.EndNanoseconds / sprites,
+					(result.RecordNanoseconds + result.EndNanoseconds) / sprites,
+					result.UploadedBytes / sprites,
+					result.DrawCalls,
+					i + 1 < p_Results.size() ? "," : "");
+		}
+
+		fprintf(p_File, "\t]\n}\n");
+	}
+}
+
+// Times recording and End (sort, gather, upload and draw) against the recording device, so results
+// measure the engine alone and are repeatable without a display. Usage: SAGEBench [output.json]
+// DrawSprites is first checked against DrawSprite and any difference fails the run. Built with
+// SAGE_TRACK_ALLOCATIONS, it then runs the allocation check instead, since counting skews timings.
+int main(int p_ArgumentCount, char* p_Arguments[])
+{
+	RecordingRenderDevice device;
+	device.SetCapturingPayloads(false);
+	IRenderDevice::Set(&device);
+
+	SpriteBatch batch;
+	if (!batch.Initialize())
+	{
+		SDL_Log("[SpriteBatchBench] Failed to initialize the sprite batch.");
+		return 1;
+	}
+
+	Effect effect;
+	if (!effect.Create(Effect::BasicType::PositionColorTexture))
+	{
+		SDL_Log("[SpriteBatchBench] Failed to create the sprite effect.");
+		return 1;
+	}
+
+	std::vector<Texture> textures(TextureCount);
+	for (int i = 0; i < TextureCount; ++i)
+	{
+		std::vector<Color> pixels(64 * 64, Color::White);
+		if (!textures[i].FromPixelColors(64, 64, pixels))
+		{
+			SDL_Log("[SpriteBatchBench] Failed to create texture %d.", i);
+			return 1;
+		}
+	}
+
+	BenchFont font;
+	if (!font.Initialize())
+	{
+		SDL_Log("[SpriteBatchBench] Failed to create the font texture.");
+		return 1;
+	}
+
+	if (CheckSpritesMatchScalar(device, effect, textures[0]) != 0)
+		return 1;
+
+	if (AllocationCounter::IsEnabled())
+	{
+		GeometryBatch geometryBatch;
+		if (!geometryBatch.Initialize())
+		{
+			SDL_Log("[SpriteBatchBench] Failed to initialize the geometry batch.");
+			return 1;
+		}
+
+		Effect geometryEffect;
+		if (!geometryEffect.Create(Effect::BasicType::PositionColor))
+		{
+			SDL_Log("[SpriteBatchBench] Failed to create the geometry effect.");
+			return 1;
+		}
+
+		return CheckAllocations(device, batch, effect, geometryBatch, geometryEffect);
+	}
+
+	std::vector<BenchResult> results;
+	for (const BenchCase& benchCase : Cases)
+	{
+		for (int count : SpriteCounts)
+		{
+			BenchResult result = Run(benchCase, count, device, batch, effect, textures, font);
+			results.push_back(result);
+
+			fprintf(stderr, "%-20s %-12s %7d sprites: %8.2f ns/sprite, %7.2f bytes/sprite, %5d draws\n",
+					benchCase.Name,
+					GetSortModeName(benchCase.Sorting),
+					count,
+					(result.RecordNanoseconds + result.EndNanoseconds) / count,
+					result.UploadedBytes / count,
+					result.DrawCalls);
+		}
+	}
+
+	FILE* file = stdout;
+	if (p_ArgumentCount > 1)
+	{
+		file = fopen(p_Arguments[1], "w");
+		if (file == nullptr)
+		{
+			SDL_Log("[SpriteBatchBench] Failed to open '%s' for writing.", p_Arguments[1]);
+			return 1;
+		}
+	}
+
+	WriteResults(file, results);
+
+	if (file != stdout)
+		fclose(file);
+
+	return 0;
+}
@@ -0,0 +1,21 @@
+// AllocationCounter.hpp
+
+#ifndef __SAGE_ALLOCATIONCOUNTER_HPP__
+#define __SAGE_ALLOCATIONCOUNTER_HPP__
+
+namespace SAGE
+{
+	// Counts heap allocations made through the global operator new.
+	// Only active when the engine is built with SAGE_TRACK_ALLOCATIONS; otherwise every count reads zero.
+	class AllocationCounter
+	{
+		public:
+			static bool IsEnabled();
+
+			static long long GetAllocationCount();
+			static long long GetAllocatedBytes();
+			static void Reset();
+	};
+}
+
+#endif
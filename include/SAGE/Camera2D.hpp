@@ -49,6 +49,7 @@ namespace SAGE
 
 			void ScreenToWorld(const Vector2& p_ScreenPosition, Vector2& p_WorldPosition) const;
 			void WorldToScreen(const Vector2& p_WorldPosition, Vector2& p_ScreenPosition) const;
+			void GetWorldBounds(Vector2& p_Minimum, Vector2& p_Maximum) const;
 
 		private:
 			static int DefaultWidth;
@@ -33,10 +33,17 @@ namespace SAGE
 			{
 				PositionColor,
 				PositionColorTexture,
+				SpriteInstance,
+				PositionColorTextureSlots,
 			};
 
+			static const int MaxTextureSlots = 8;
+
 			bool Create(BasicType p_BasicType);
 
+			// Only effects created as PositionColorTextureSlots read the per-vertex texture slot.
+			bool ReadsTextureSlots() const;
+
 			bool Initialize();
 			bool Finalize();
 
@@ -58,8 +65,12 @@ namespace SAGE
 			static const std::string PositionColorFragmentSource;
 			static const std::string PositionColorTextureVertexSource;
 			static const std::string PositionColorTextureFragmentSource;
+			static const std::string SpriteInstanceVertexSource;
+			static const std::string PositionColorTextureSlotsVertexSource;
+			static const std::string PositionColorTextureSlotsFragmentSource;
 
 			GLuint m_Program;
+			bool m_ReadsTextureSlots;
 			GLint m_ProjectionMatrixLocation;
 			GLint m_ModelViewMatrixLocation;
 			std::map<std::string, GLint> m_Uniforms;
@@ -0,0 +1,73 @@
+// FrameLimiter.hpp
+
+#ifndef __SAGE_FRAMELIMITER_HPP__
+#define __SAGE_FRAMELIMITER_HPP__
+
+// SDL Includes
+#include <SDL2/SDL.h>
+// STL Includes
+#include <vector>
+
+namespace SAGE
+{
+	// Rolling frame times in milliseconds over the last WindowSize frames.
+	class FrameTimeHistory
+	{
+		public:
+			static const int DefaultWindowSize = 240;
+
+			FrameTimeHistory(int p_WindowSize = DefaultWindowSize);
+			~FrameTimeHistory();
+
+			int GetWindowSize() const;
+			int GetFrameCount() const;
+			float GetLatest() const;
+			float GetAverage() const;
+			float GetMaximum() const;
+
+			// p_Percentile is in [0, 100]; 50, 95 and 99 give the usual p50/p95/p99.
+			float GetPercentile(float p_Percentile) const;
+
+			// Changing the window size discards the history.
+			void SetWindowSize(int p_WindowSize);
+			void Push(float p_Milliseconds);
+			void Clear();
+
+		private:
+			int m_Next;
+			int m_FrameCount;
+			std::vector<float> m_Frames;
+			mutable std::vector<float> m_Sorted;
+	};
+
+	// Paces frames to a target rate. Waits sleep until shortly before the deadline, then spin for the
+	// remainder, since sleeps overshoot by up to a scheduler tick.
+	class FrameLimiter
+	{
+		public:
+			static const Uint64 DefaultSpinNanoseconds = 2000000;
+
+			FrameLimiter();
+			~FrameLimiter();
+
+			int GetTargetRate() const;
+			bool IsEnabled() const;
+			Uint64 GetSpinNanoseconds() const;
+
+			// A rate of zero or less disables limiting.
+			void SetTargetRate(int p_FramesPerSecond);
+			void SetSpinNanoseconds(Uint64 p_Nanoseconds);
+
+			// Call once per frame; returns once the frame's deadline has passed.
+			void Wait();
+
+		private:
+			int m_TargetRate;
+			Uint64 m_Period;
+			Uint64 m_SpinCount;
+			Uint64 m_SpinNanoseconds;
+			Uint64 m_Deadline;
+	};
+}
+
+#endif
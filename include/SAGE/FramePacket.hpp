@@ -0,0 +1,70 @@
+// FramePacket.hpp
+
+#ifndef __SAGE_FRAMEPACKET_HPP__
+#define __SAGE_FRAMEPACKET_HPP__
+
+// SAGE Includes
+#include <SAGE/Camera2D.hpp>
+#include <SAGE/Effect.hpp>
+#include <SAGE/SpriteBatch.hpp>
+#include <SAGE/SpriteRecorder.hpp>
+#include <SAGE/VertexDefinitions.hpp>
+// STL Includes
+#include <memory>
+#include <vector>
+
+namespace SAGE
+{
+	// One SpriteBatch draw pair. Recorder holds what was drawn through the batch and Submitted
+	// what came from submitted recorders, in the order the batch would have merged them.
+	struct SpritePass
+	{
+		Effect* PassEffect;
+		Camera2D Camera;
+		SortMode Sorting;
+		BlendMode Blending;
+		RasterizerState Rasterizer;
+		SpriteRecorder Recorder;
+		SpriteRecorder Submitted;
+	};
+
+	// One GeometryBatch draw pair as pairs of line vertices.
+	struct GeometryPass
+	{
+		Effect* PassEffect;
+		Camera2D Camera;
+		std::vector<VertexPositionColor> Vertices;
+	};
+
+	// Everything a frame drew, captured by the batches so another thread can replay it.
+	// Clearing keeps every pass's storage, so a packet that is reused each frame stops allocating.
+	class FramePacket
+	{
+		public:
+			FramePacket();
+			~FramePacket();
+
+			int GetSpritePassCount() const;
+			int GetGeometryPassCount() const;
+			const SpritePass& GetSpritePass(int p_Index) const;
+			const GeometryPass& GetGeometryPass(int p_Index) const;
+
+			// Signalled once the GL work issued while recording the packet (texture uploads and so on) is done.
+			GLsync GetUploadFence() const;
+			void SetUploadFence(GLsync p_Fence);
+
+			SpritePass& AddSpritePass(Effect& p_Effect, const Camera2D& p_Camera, SortMode p_SortMode, BlendMode p_BlendMode, RasterizerState p_RasterizerState);
+			GeometryPass& AddGeometryPass(Effect& p_Effect, const Camera2D& p_Camera);
+
+			void Clear();
+
+		private:
+			int m_SpritePassCount;
+			int m_GeometryPassCount;
+			std::vector<std::unique_ptr<SpritePass>> m_SpritePasses;
+			std::vector<std::unique_ptr<GeometryPass>> m_GeometryPasses;
+			GLsync m_UploadFence;
+	};
+}
+
+#endif
@@ -4,9 +4,14 @@
 #define __SAGE_GAME_HPP__
 
 // SAGE Includes
+#include <SAGE/FrameLimiter.hpp>
 #include <SAGE/GeometryBatch.hpp>
+#include <SAGE/JobSystem.hpp>
+#include <SAGE/RenderStats.hpp>
+#include <SAGE/RenderThread.hpp>
 #include <SAGE/SpriteBatch.hpp>
 #include <SAGE/ScreenManager.hpp>
+#include <SAGE/TextureStreamer.hpp>
 #include <SAGE/Timer.hpp>
 #include <SAGE/Window.hpp>
 
@@ -15,11 +20,42 @@ namespace SAGE
 	class Game
 	{
 		public:
+			static const int DefaultMaxStepsPerFrame = 5;
+
 			Game();
 			virtual ~Game();
 
 			Window* GetWindow() const;
 			ScreenManager* GetScreenManager() const;
+			JobSystem* GetJobSystem();
+			TextureStreamer* GetTextureStreamer();
+			const RenderStatsHistory& GetRenderStats() const;
+			bool IsFixedTimestep() const;
+			float GetFixedTimestep() const;
+			int GetMaxStepsPerFrame() const;
+			float GetInterpolationAlpha() const;
+			int GetFrameRateLimit() const;
+			const FrameTimeHistory& GetFrameTimes() const;
+			bool IsThreadedRendering() const;
+
+			// How many frames the rolling render statistics cover; resets the history.
+			void SetRenderStatsWindow(int p_FrameCount);
+
+			// Update runs in steps of exactly p_Step seconds, at most p_MaxStepsPerFrame times per frame;
+			// time beyond that is dropped instead of being caught up. Render receives how far the
+			// simulation is into the next step, for blending the previous and current states.
+			void SetFixedTimestep(float p_Step, int p_MaxStepsPerFrame = DefaultMaxStepsPerFrame);
+			void DisableFixedTimestep();
+
+			// Caps the loop at p_FramesPerSecond when vsync doesn't; zero removes the cap.
+			void SetFrameRateLimit(int p_FramesPerSecond);
+
+			// Must be chosen before Start. When enabled, Render records the frame into a packet and a
+			// render thread draws it while the next frame is simulated, so the screen is a frame behind
+			// and render statistics lag by one more. Only SpriteBatch and GeometryBatch draws are
+			// captured; effects and textures must stay alive for a frame after their last use, and
+			// window state such as the clear color and vsync must be set in Initialize.
+			void SetThreadedRendering(bool p_Enabled);
 
 			int Start();
 			void Quit();
@@ -32,14 +68,32 @@ namespace SAGE
 			virtual int Render(SpriteBatch& p_SpriteBatch);
 			virtual int Render(GeometryBatch& p_GeometryBatch);
 
+			// Called by the game loop; the defaults ignore the interpolation alpha and call the overloads above.
+			virtual int Render(SpriteBatch& p_SpriteBatch, float p_Alpha);
+			virtual int Render(GeometryBatch& p_GeometryBatch, float p_Alpha);
+
 			Window* m_Window;
 			ScreenManager* m_ScreenManager;
 
 		private:
+			int Simulate(float p_DeltaTime);
+
 			Timer m_Timer;
 			SpriteBatch m_SpriteBatch;
 			GeometryBatch m_GeometryBatch;
+			RenderStatsHistory m_RenderStats;
+			JobSystem m_JobSystem;
+			TextureStreamer m_TextureStreamer;
+			FrameLimiter m_FrameLimiter;
+			FrameTimeHistory m_FrameTimes;
+			RenderThread m_RenderThread;
+			bool m_ThreadedRendering;
 			bool m_Running;
+			bool m_FixedTimestep;
+			float m_FixedStep;
+			int m_MaxStepsPerFrame;
+			double m_Accumulator;
+			float m_InterpolationAlpha;
 	};
 }
 
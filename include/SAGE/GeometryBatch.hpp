@@ -8,6 +8,8 @@
 #include <SAGE/Color.hpp>
 #include <SAGE/Effect.hpp>
 #include <SAGE/Rectangle.hpp>
+#include <SAGE/RenderStats.hpp>
+#include <SAGE/UnitCircle.hpp>
 #include <SAGE/Vector2.hpp>
 #include <SAGE/VertexDefinitions.hpp>
 // STL Includes
@@ -15,6 +17,9 @@
 
 namespace SAGE
 {
+	class FramePacket;
+	struct GeometryPass;
+
 	class GeometryBatch
 	{
 		private:
@@ -27,18 +32,30 @@ namespace SAGE
 			~GeometryBatch();
 
 			int GetDrawCallCount() const;
+			const RenderStats& GetStats() const;
+			bool IsCapturing() const;
 
 			bool Initialize();
 			bool Finalize();
 
+			// Statistics accumulate over every draw pair until reset.
+			void ResetStats();
+
+			// While a packet is set, draw pairs are recorded into it instead of reaching GL.
+			bool SetCapture(FramePacket* p_Packet);
+
 			bool Begin(Effect& p_Effect, const Camera2D& p_Camera = Camera2D::DefaultCamera);
 			bool DrawLine(const Vector2& p_PositionA, const Vector2& p_PositionB, const Color& p_Color);
 			bool DrawLines(const std::vector<Vector2>& p_Positions, const Color& p_Color);
+			bool DrawLines(const Vector2* p_Positions, int p_PositionCount, const Color& p_Color);
 			bool DrawRectangle(const Vector2& p_TopLeft, const Vector2& p_BottomRight, const Color& p_Color);
 			bool DrawRectangle(const Rectangle& p_Rectangle, const Color& p_Color);
 			bool DrawCircle(const Vector2& p_Position, float p_Radius, const Color& p_Color, int p_Count = 25);
+			bool DrawCircle(const Vector2& p_Position, float p_Radius, const Color& p_Color, const UnitCircle& p_Circle);
 			bool DrawBezier(const Vector2& p_StartPosition, const Vector2& p_EndPosition, const Vector2& p_ControlPoint, const Color& p_Color, int p_Count = 25);
 			bool DrawBezier(const Vector2& p_StartPosition, const Vector2& p_EndPosition, const Vector2& p_ControlPointA, const Vector2& p_ControlPointB, const Color& p_Color, int p_Count = 25);
+			// Draws prepared line vertices, two per line, as captured in a GeometryPass.
+			bool DrawLineList(const VertexPositionColor* p_Vertices, int p_VertexCount);
 			bool End();
 
 		private:
@@ -59,6 +76,10 @@ namespace SAGE
 			GLuint m_IndexBufferObject;
 			GeometryBatchItem m_BatchItemList[MaxBatchSize];
 			VertexPositionColor m_VertexBuffer[MaxVertexCount];
+			UnitCircle m_Circle;
+			RenderStats m_Stats;
+			FramePacket* m_Capture;
+			GeometryPass* m_CapturePass;
 	};
 }
 
@@ -0,0 +1,104 @@
+// IRenderDevice.hpp
+
+#ifndef __SAGE_IRENDERDEVICE_HPP__
+#define __SAGE_IRENDERDEVICE_HPP__
+
+// OpenGL Includes
+#if defined __ANDROID__
+	#include <GLES3/gl3.h>
+#else
+	#include <GL/glew.h>
+#endif
+
+namespace SAGE
+{
+	// Every graphics call the engine makes goes through the current device. Methods mirror the
+	// OpenGL entry points they replace, so GLRenderDevice is a straight pass-through.
+	class IRenderDevice
+	{
+		public:
+			IRenderDevice() = default;
+			virtual ~IRenderDevice() = default;
+
+			// The device used by every batch, texture and effect; defaults to the shared GL device.
+			static IRenderDevice& Get();
+			static void Set(IRenderDevice* p_Device);
+
+			virtual bool Initialize() = 0;
+			virtual bool SupportsBufferStorage() const = 0;
+
+			// Buffers
+			virtual void GenBuffers(GLsizei p_Count, GLuint* p_Buffers) = 0;
+			virtual void DeleteBuffers(GLsizei p_Count, const GLuint* p_Buffers) = 0;
+			virtual void BindBuffer(GLenum p_Target, GLuint p_Buffer) = 0;
+			virtual void BufferData(GLenum p_Target, GLsizeiptr p_Size, const void* p_Data, GLenum p_Usage) = 0;
+			virtual void BufferSubData(GLenum p_Target, GLintptr p_Offset, GLsizeiptr p_Size, const void* p_Data) = 0;
+			virtual void BufferStorage(GLenum p_Target, GLsizeiptr p_Size, const void* p_Data, GLbitfield p_Flags) = 0;
+			virtual void* MapBufferRange(GLenum p_Target, GLintptr p_Offset, GLsizeiptr p_Length, GLbitfield p_Access) = 0;
+			virtual GLboolean UnmapBuffer(GLenum p_Target) = 0;
+
+			// Vertex arrays
+			virtual void GenVertexArrays(GLsizei p_Count, GLuint* p_Arrays) = 0;
+			virtual void DeleteVertexArrays(GLsizei p_Count, const GLuint* p_Arrays) = 0;
+			virtual void BindVertexArray(GLuint p_Array) = 0;
+			virtual void EnableVertexAttribArray(GLuint p_Index) = 0;
+			virtual void VertexAttribPointer(GLuint p_Index, GLint p_Size, GLenum p_Type, GLboolean p_Normalized, GLsizei p_Stride, const void* p_Offset) = 0;
+			virtual void VertexAttribIPointer(GLuint p_Index, GLint p_Size, GLenum p_Type, GLsizei p_Stride, const void* p_Offset) = 0;
+			virtual void VertexAttribDivisor(GLuint p_Index, GLuint p_Divisor) = 0;
+
+			// Textures
+			virtual void GenTextures(GLsizei p_Count, GLuint* p_Textures) = 0;
+			virtual void DeleteTextures(GLsizei p_Count, const GLuint* p_Textures) = 0;
+			virtual void ActiveTexture(GLenum p_Unit) = 0;
+			virtual void BindTexture(GLenum p_Target, GLuint p_Texture) = 0;
+			virtual void TexImage2D(GLenum p_Target, GLint p_Level, GLint p_InternalFormat, GLsizei p_Width, GLsizei p_Height, GLint p_Border, GLenum p_Format, GLenum p_Type, const void* p_Pixels) = 0;
+			virtual void TexSubImage2D(GLenum p_Target, GLint p_Level, GLint p_X, GLint p_Y, GLsizei p_Width, GLsizei p_Height, GLenum p_Format, GLenum p_Type, const void* p_Pixels) = 0;
+			virtual void TexParameteri(GLenum p_Target, GLenum p_Name, GLint p_Value) = 0;
+			virtual void TexParameterfv(GLenum p_Target, GLenum p_Name, const GLfloat* p_Values) = 0;
+
+			// Shaders and programs
+			virtual GLuint CreateShader(GLenum p_Type) = 0;
+			virtual void ShaderSource(GLuint p_Shader, GLsizei p_Count, const GLchar* const* p_Sources, const GLint* p_Lengths) = 0;
+			virtual void CompileShader(GLuint p_Shader) = 0;
+			virtual void GetShaderiv(GLuint p_Shader, GLenum p_Name, GLint* p_Value) = 0;
+			virtual void GetShaderInfoLog(GLuint p_Shader, GLsizei p_MaxLength, GLsizei* p_Length, GLchar* p_Log) = 0;
+			virtual void DeleteShader(GLuint p_Shader) = 0;
+			virtual GLuint CreateProgram() = 0;
+			virtual void AttachShader(GLuint p_Program, GLuint p_Shader) = 0;
+			virtual void LinkProgram(GLuint p_Program) = 0;
+			virtual void GetProgramiv(GLuint p_Program, GLenum p_Name, GLint* p_Value) = 0;
+			virtual void GetProgramInfoLog(GLuint p_Program, GLsizei p_MaxLength, GLsizei* p_Length, GLchar* p_Log) = 0;
+			virtual void GetActiveUniform(GLuint p_Program, GLuint p_Index, GLsizei p_MaxLength, GLsizei* p_Length, GLint* p_Size, GLenum* p_Type, GLchar* p_Name) = 0;
+			virtual void DeleteProgram(GLuint p_Program) = 0;
+			virtual void UseProgram(GLuint p_Program) = 0;
+			virtual GLint GetUniformLocation(GLuint p_Program, const GLchar* p_Name) = 0;
+			virtual void Uniform1i(GLint p_Location, GLint p_Value) = 0;
+			virtual void Uniform1f(GLint p_Location, GLfloat p_Value) = 0;
+			virtual void UniformMatrix4fv(GLint p_Location, GLsizei p_Count, GLboolean p_Transpose, const GLfloat* p_Values) = 0;
+
+			// Fixed-function state
+			virtual void Enable(GLenum p_Capability) = 0;
+			virtual void Disable(GLenum p_Capability) = 0;
+			virtual void BlendFunc(GLenum p_Source, GLenum p_Destination) = 0;
+			virtual void CullFace(GLenum p_Face) = 0;
+			virtual void Viewport(GLint p_X, GLint p_Y, GLsizei p_Width, GLsizei p_Height) = 0;
+			virtual void ClearColor(GLfloat p_Red, GLfloat p_Green, GLfloat p_Blue, GLfloat p_Alpha) = 0;
+			virtual void Clear(GLbitfield p_Mask) = 0;
+
+			// Drawing
+			virtual void DrawElements(GLenum p_Mode, GLsizei p_Count, GLenum p_Type, const void* p_Indices) = 0;
+			virtual void DrawElementsBaseVertex(GLenum p_Mode, GLsizei p_Count, GLenum p_Type, const void* p_Indices, GLint p_BaseVertex) = 0;
+			virtual void DrawArraysInstanced(GLenum p_Mode, GLint p_First, GLsizei p_Count, GLsizei p_InstanceCount) = 0;
+
+			// Synchronization
+			virtual GLsync FenceSync(GLenum p_Condition, GLbitfield p_Flags) = 0;
+			virtual GLenum ClientWaitSync(GLsync p_Sync, GLbitfield p_Flags, GLuint64 p_Timeout) = 0;
+			virtual void DeleteSync(GLsync p_Sync) = 0;
+			virtual void Flush() = 0;
+
+		private:
+			static IRenderDevice* sDevice;
+	};
+}
+
+#endif
@@ -0,0 +1,101 @@
+// JobSystem.hpp
+
+#ifndef __SAGE_JOBSYSTEM_HPP__
+#define __SAGE_JOBSYSTEM_HPP__
+
+// STL Includes
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SAGE
+{
+	// Counts outstanding jobs. Schedule increments it, completion decrements it; zero means done.
+	class JobCounter
+	{
+		public:
+			JobCounter();
+			~JobCounter();
+
+			int GetCount() const;
+			bool IsDone() const;
+
+		private:
+			friend class JobSystem;
+
+			std::atomic<int> m_Count;
+	};
+
+	typedef std::function<void()> Job;
+	typedef std::function<void(int p_First, int p_Last)> JobRange;
+
+	// Runs jobs on one worker per core. Each worker pops its own deque newest first and steals the
+	// oldest jobs from the others when it runs dry; threads that Wait help run jobs instead of blocking.
+	// Background jobs sit in a queue of their own that only workers take from.
+	class JobSystem
+	{
+		public:
+			JobSystem();
+			~JobSystem();
+
+			bool IsRunning() const;
+			int GetWorkerCount() const;
+
+			// A worker count of zero or less uses one worker per core besides the calling thread.
+			bool Initialize(int p_WorkerCount = 0);
+			bool Finalize();
+
+			// p_Counter, if given, is incremented now and decremented when the job finishes.
+			// A job with a dependency is held back until that counter reaches zero. The dependency must stay
+			// alive until its dependent jobs have been scheduled, as they are matched to it by address.
+			void Schedule(const Job& p_Job, JobCounter* p_Counter = nullptr, const JobCounter* p_Dependency = nullptr);
+			// For long jobs such as loading and decoding. Only workers run them, once they have nothing else,
+			// so a thread in Wait or ParallelFor never picks one up and stalls on it.
+			void ScheduleBackground(const Job& p_Job, JobCounter* p_Counter = nullptr);
+			// Helps run other queued jobs meanwhile, but never background ones.
+			void Wait(const JobCounter& p_Counter);
+
+			// Calls p_Body over [p_Begin, p_End) in chunks of p_Grain indices and returns when all are done.
+			// A grain of zero or less picks one that gives each thread a few chunks.
+			void ParallelFor(int p_Begin, int p_End, const JobRange& p_Body, int p_Grain = 0);
+
+		private:
+			struct QueuedJob
+			{
+				Job Work;
+				JobCounter* Counter;
+				const JobCounter* Dependency;
+				bool Background;
+			};
+
+			struct WorkerQueue
+			{
+				std::mutex Mutex;
+				std::deque<QueuedJob> Jobs;
+			};
+
+			void Enqueue(QueuedJob&& p_Job);
+			bool RunNext(bool p_Background);
+			bool PopJob(QueuedJob& p_Job, bool p_Background);
+			void Complete(JobCounter* p_Counter);
+			void ReleasePending(const JobCounter* p_Dependency, std::vector<QueuedJob>& p_Ready);
+			void WorkerMain(int p_Index);
+
+			std::atomic<bool> m_Running;
+			std::atomic<int> m_QueuedCount;
+			std::vector<std::unique_ptr<WorkerQueue>> m_Queues;
+			WorkerQueue m_BackgroundQueue;
+			std::vector<std::thread> m_Workers;
+			std::mutex m_WakeMutex;
+			std::condition_variable m_WakeCondition;
+			std::mutex m_PendingMutex;
+			std::vector<QueuedJob> m_Pending;
+	};
+}
+
+#endif
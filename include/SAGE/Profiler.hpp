@@ -0,0 +1,85 @@
+// Profiler.hpp
+
+#ifndef __SAGE_PROFILER_HPP__
+#define __SAGE_PROFILER_HPP__
+
+// SDL Includes
+#include <SDL2/SDL.h>
+// STL Includes
+#include <string>
+
+// Zones only exist when the engine is built with SAGE_ENABLE_PROFILER; otherwise every macro expands to nothing.
+// Zone and thread names must be string literals, since only the pointer is recorded.
+#if defined SAGE_ENABLE_PROFILER
+	#define SAGE_PROFILE_CONCATENATE_INNER(p_A, p_B) p_A##p_B
+	#define SAGE_PROFILE_CONCATENATE(p_A, p_B) SAGE_PROFILE_CONCATENATE_INNER(p_A, p_B)
+	#define SAGE_PROFILE_ZONE(p_Name) SAGE::ProfilerZone SAGE_PROFILE_CONCATENATE(sageProfilerZone, __LINE__)(p_Name)
+	#define SAGE_PROFILE_FRAME() SAGE::Profiler::MarkFrame()
+	#define SAGE_PROFILE_THREAD(p_Name) SAGE::Profiler::SetThreadName(p_Name)
+#else
+	#define SAGE_PROFILE_ZONE(p_Name)
+	#define SAGE_PROFILE_FRAME()
+	#define SAGE_PROFILE_THREAD(p_Name)
+#endif
+
+namespace SAGE
+{
+	struct ProfilerEvent
+	{
+		const char* Name;
+		Uint64 Start;
+		Uint64 End;
+		int Depth;
+	};
+
+	// Records nested CPU zones into a fixed ring per thread. Only the owning thread writes its ring,
+	// so recording a zone never locks; the oldest events are overwritten once a ring is full.
+	class Profiler
+	{
+		public:
+			static const int EventCapacity = 1 << 16;
+			static const int FrameCapacity = 256;
+
+			static bool IsEnabled();
+
+			static void MarkFrame();
+			static void SetThreadName(const char* p_Name);
+
+			// Writes the last complete frames from every thread as Chrome trace JSON (chrome://tracing or Perfetto).
+			static bool WriteChromeTrace(const std::string& p_Filename, int p_FrameCount = 1);
+
+#if defined SAGE_ENABLE_PROFILER
+			static void Record(const char* p_Name, Uint64 p_Start, Uint64 p_End, int p_Depth);
+			static int& GetDepth();
+#endif
+	};
+
+#if defined SAGE_ENABLE_PROFILER
+	class ProfilerZone
+	{
+		public:
+			explicit ProfilerZone(const char* p_Name)
+			{
+				m_Name = p_Name;
+				m_Depth = Profiler::GetDepth()++;
+				m_Start = SDL_GetPerformanceCounter();
+			}
+
+			~ProfilerZone()
+			{
+				Profiler::Record(m_Name, m_Start, SDL_GetPerformanceCounter(), m_Depth);
+				Profiler::GetDepth()--;
+			}
+
+			ProfilerZone(const ProfilerZone&) = delete;
+			ProfilerZone& operator=(const ProfilerZone&) = delete;
+
+		private:
+			const char* m_Name;
+			Uint64 m_Start;
+			int m_Depth;
+	};
+#endif
+}
+
+#endif
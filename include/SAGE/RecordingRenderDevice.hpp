@@ -0,0 +1,194 @@
+// RecordingRenderDevice.hpp
+
+#ifndef __SAGE_RECORDINGRENDERDEVICE_HPP__
+#define __SAGE_RECORDINGRENDERDEVICE_HPP__
+
+// SAGE Includes
+#include <SAGE/IRenderDevice.hpp>
+// STL Includes
+#include <map>
+#include <string>
+#include <vector>
+
+namespace SAGE
+{
+	enum class RenderCommandType
+	{
+		GenBuffers,
+		DeleteBuffers,
+		BindBuffer,
+		BufferData,
+		BufferSubData,
+		BufferStorage,
+		MapBufferRange,
+		UnmapBuffer,
+		GenVertexArrays,
+		DeleteVertexArrays,
+		BindVertexArray,
+		EnableVertexAttribArray,
+		VertexAttribPointer,
+		VertexAttribIPointer,
+		VertexAttribDivisor,
+		GenTextures,
+		DeleteTextures,
+		ActiveTexture,
+		BindTexture,
+		TexImage2D,
+		TexSubImage2D,
+		TexParameter,
+		CreateShader,
+		CompileShader,
+		DeleteShader,
+		CreateProgram,
+		AttachShader,
+		LinkProgram,
+		DeleteProgram,
+		UseProgram,
+		Uniform,
+		Enable,
+		Disable,
+		BlendFunc,
+		CullFace,
+		Viewport,
+		ClearColor,
+		Clear,
+		DrawElements,
+		DrawElementsBaseVertex,
+		DrawArraysInstanced,
+		FenceSync,
+		ClientWaitSync,
+		DeleteSync,
+		Flush,
+	};
+
+	// One recorded call. Target holds the call's target, mode, capability or unit; Object is the
+	// buffer, texture, program, shader, vertex array or sync it acted on (the bound one for uploads
+	// and draws). Arguments hold the remaining integers in call order, and Payload a copy of any
+	// data or float values passed in.
+	struct RenderCommand
+	{
+		RenderCommandType Type;
+		GLenum Target;
+		GLuint Object;
+		GLint64 Arguments[4];
+		std::vector<unsigned char> Payload;
+	};
+
+	// Records every call into an inspectable log instead of talking to a GPU, so batching,
+	// sorting and state changes can be tested and benchmarked without a display.
+	// Buffers keep their contents, including writes through mapped pointers.
+	class RecordingRenderDevice : public IRenderDevice
+	{
+		public:
+			RecordingRenderDevice();
+			~RecordingRenderDevice();
+
+			const std::vector<RenderCommand>& GetCommands() const;
+			int GetCommandCount(RenderCommandType p_Type) const;
+			int GetDrawCallCount() const;
+			const std::vector<unsigned char>& GetBufferContents(GLuint p_Buffer) const;
+			bool IsCapturingPayloads() const;
+
+			// Copying uploads is the costly part of recording; benchmarks can switch it off.
+			void SetCapturingPayloads(bool p_Capturing);
+			void ClearCommands();
+
+			bool Initialize() override;
+			bool SupportsBufferStorage() const override;
+
+			// Buffers
+			void GenBuffers(GLsizei p_Count, GLuint* p_Buffers) override;
+			void DeleteBuffers(GLsizei p_Count, const GLuint* p_Buffers) override;
+			void BindBuffer(GLenum p_Target, GLuint p_Buffer) override;
+			void BufferData(GLenum p_Target, GLsizeiptr p_Size, const void* p_Data, GLenum p_Usage) override;
+			void BufferSubData(GLenum p_Target, GLintptr p_Offset, GLsizeiptr p_Size, const void* p_Data) override;
+			void BufferStorage(GLenum p_Target, GLsizeiptr p_Size, const void* p_Data, GLbitfield p_Flags) override;
+			void* MapBufferRange(GLenum p_Target, GLintptr p_Offset, GLsizeiptr p_Length, GLbitfield p_Access) override;
+			GLboolean UnmapBuffer(GLenum p_Target) override;
+
+			// Vertex arrays
+			void GenVertexArrays(GLsizei p_Count, GLuint* p_Arrays) override;
+			void DeleteVertexArrays(GLsizei p_Count, const GLuint* p_Arrays) override;
+			void BindVertexArray(GLuint p_Array) override;
+			void EnableVertexAttribArray(GLuint p_Index) override;
+			void VertexAttribPointer(GLuint p_Index, GLint p_Size, GLenum p_Type, GLboolean p_Normalized, GLsizei p_Stride, const void* p_Offset) override;
+			void VertexAttribIPointer(GLuint p_Index, GLint p_Size, GLenum p_Type, GLsizei p_Stride, const void* p_Offset) override;
+			void VertexAttribDivisor(GLuint p_Index, GLuint p_Divisor) override;
+
+			// Textures
+			void GenTextures(GLsizei p_Count, GLuint* p_Textures) override;
+			void DeleteTextures(GLsizei p_Count, const GLuint* p_Textures) override;
+			void ActiveTexture(GLenum p_Unit) override;
+			void BindTexture(GLenum p_Target, GLuint p_Texture) override;
+			void TexImage2D(GLenum p_Target, GLint p_Level, GLint p_InternalFormat, GLsizei p_Width, GLsizei p_Height, GLint p_Border, GLenum p_Format, GLenum p_Type, const void* p_Pixels) override;
+			void TexSubImage2D(GLenum p_Target, GLint p_Level, GLint p_X, GLint p_Y, GLsizei p_Width, GLsizei p_Height, GLenum p_Format, GLenum p_Type, const void* p_Pixels) override;
+			void TexParameteri(GLenum p_Target, GLenum p_Name, GLint p_Value) override;
+			void TexParameterfv(GLenum p_Target, GLenum p_Name, const GLfloat* p_Values) override;
+
+			// Shaders and programs
+			GLuint CreateShader(GLenum p_Type) override;
+			void ShaderSource(GLuint p_Shader, GLsizei p_Count, const GLchar* const* p_Sources, const GLint* p_Lengths) override;
+			void CompileShader(GLuint p_Shader) override;
+			void GetShaderiv(GLuint p_Shader, GLenum p_Name, GLint* p_Value) override;
+			void GetShaderInfoLog(GLuint p_Shader, GLsizei p_MaxLength, GLsizei* p_Length, GLchar* p_Log) override;
+			void DeleteShader(GLuint p_Shader) override;
+			GLuint CreateProgram() override;
+			void AttachShader(GLuint p_Program, GLuint p_Shader) override;
+			void LinkProgram(GLuint p_Program) override;
+			void GetProgramiv(GLuint p_Program, GLenum p_Name, GLint* p_Value) override;
+			void GetProgramInfoLog(GLuint p_Program, GLsizei p_MaxLength, GLsizei* p_Length, GLchar* p_Log) override;
+			void GetActiveUniform(GLuint p_Program, GLuint p_Index, GLsizei p_MaxLength, GLsizei* p_Length, GLint* p_Size, GLenum* p_Type, GLchar* p_Name) override;
+			void DeleteProgram(GLuint p_Program) override;
+			void UseProgram(GLuint p_Program) override;
+			GLint GetUniformLocation(GLuint p_Program, const GLchar* p_Name) override;
+			void Uniform1i(GLint p_Location, GLint p_Value) override;
+			void Uniform1f(GLint p_Location, GLfloat p_Value) override;
+			void UniformMatrix4fv(GLint p_Location, GLsizei p_Count, GLboolean p_Transpose, const GLfloat* p_Values) override;
+
+			// Fixed-function state
+			void Enable(GLenum p_Capability) override;
+			void Disable(GLenum p_Capability) override;
+			void BlendFunc(GLenum p_Source, GLenum p_Destination) override;
+			void CullFace(GLenum p_Face) override;
+			void Viewport(GLint p_X, GLint p_Y, GLsizei p_Width, GLsizei p_Height) override;
+			void ClearColor(GLfloat p_Red, GLfloat p_Green, GLfloat p_Blue, GLfloat p_Alpha) override;
+			void Clear(GLbitfield p_Mask) override;
+
+			// Drawing
+			void DrawElements(GLenum p_Mode, GLsizei p_Count, GLenum p_Type, const void* p_Indices) override;
+			void DrawElementsBaseVertex(GLenum p_Mode, GLsizei p_Count, GLenum p_Type, const void* p_Indices, GLint p_BaseVertex) override;
+			void DrawArraysInstanced(GLenum p_Mode, GLint p_First, GLsizei p_Count, GLsizei p_InstanceCount) override;
+
+			// Synchronization
+			GLsync FenceSync(GLenum p_Condition, GLbitfield p_Flags) override;
+			GLenum ClientWaitSync(GLsync p_Sync, GLbitfield p_Flags, GLuint64 p_Timeout) override;
+			void DeleteSync(GLsync p_Sync) override;
+			void Flush() override;
+
+		private:
+			RenderCommand& Record(RenderCommandType p_Type, GLenum p_Target = 0, GLuint p_Object = 0, GLint64 p_A = 0, GLint64 p_B = 0, GLint64 p_C = 0, GLint64 p_D = 0);
+			void CapturePayload(RenderCommand& p_Command, const void* p_Data, size_t p_Size);
+			void GenerateNames(GLsizei p_Count, GLuint* p_Names);
+			GLuint& GetBufferBinding(GLenum p_Target);
+			GLuint GetBoundTexture() const;
+
+			static const int MaxTextureUnits = 32;
+
+			bool m_CapturingPayloads;
+			GLuint m_NextName;
+			GLuint m_ArrayBuffer;
+			GLuint m_ElementArrayBuffer;
+			GLuint m_PixelUnpackBuffer;
+			GLuint m_OtherBuffer;
+			GLuint m_VertexArray;
+			GLuint m_Program;
+			int m_ActiveTexture;
+			GLuint m_Textures[MaxTextureUnits];
+			std::vector<RenderCommand> m_Commands;
+			std::map<GLuint, std::vector<unsigned char>> m_BufferContents;
+			std::map<GLuint, GLuint> m_VertexArrayElementBuffers;
+			std::map<std::pair<GLuint, std::string>, GLint> m_UniformLocations;
+	};
+}
+
+#endif
@@ -0,0 +1,64 @@
+// RenderState.hpp
+
+#ifndef __SAGE_RENDERSTATE_HPP__
+#define __SAGE_RENDERSTATE_HPP__
+
+// OpenGL Includes
+#if defined __ANDROID__
+	#include <GLES3/gl3.h>
+#else
+	#include <GL/glew.h>
+#endif
+
+namespace SAGE
+{
+	// Shadows the GL bindings and fixed-function state the engine changes so redundant calls can be skipped.
+	// Anything that changes this state outside of RenderState must call Reset() afterwards.
+	// The shadow is per thread, matching the context current on it; a thread that switches contexts must Reset().
+	class RenderState
+	{
+		public:
+			static const int MaxTextureUnits = 16;
+
+			static void Reset();
+
+			static void UseProgram(GLuint p_Program);
+			static void BindVertexArray(GLuint p_VertexArray);
+			static void BindBuffer(GLenum p_Target, GLuint p_Buffer);
+			static void BindTexture(int p_Unit, GLuint p_Texture);
+			static void SetBlend(bool p_Enabled, GLenum p_Source = GL_ONE, GLenum p_Destination = GL_ZERO);
+			static void SetCulling(bool p_Enabled, GLenum p_Face = GL_BACK);
+
+			static void ForgetVertexArray(GLuint p_VertexArray);
+			static void ForgetBuffer(GLuint p_Buffer);
+			static void ForgetTexture(GLuint p_Texture);
+
+			static int GetIssuedCallCount();
+			static int GetSkippedCallCount();
+			static int GetTextureBindCount();
+			static void ResetCallCounts();
+
+		private:
+			static const GLuint UnknownBinding = 0xFFFFFFFF;
+
+			static void SetActiveTexture(int p_Unit);
+			static bool Skip(bool p_Redundant);
+
+			static thread_local GLuint sProgram;
+			static thread_local GLuint sVertexArray;
+			static thread_local GLuint sArrayBuffer;
+			static thread_local GLuint sElementArrayBuffer;
+			static thread_local int sActiveTexture;
+			static thread_local GLuint sTextures[MaxTextureUnits];
+			static thread_local int sBlendEnabled;
+			static thread_local GLenum sBlendSource;
+			static thread_local GLenum sBlendDestination;
+			static thread_local int sCullEnabled;
+			static thread_local GLenum sCullFace;
+			static thread_local int sIssuedCallCount;
+			static thread_local int sSkippedCallCount;
+			static thread_local int sTextureBindCount;
+	};
+}
+
+#endif
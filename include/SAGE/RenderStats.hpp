@@ -0,0 +1,76 @@
+// RenderStats.hpp
+
+#ifndef __SAGE_RENDERSTATS_HPP__
+#define __SAGE_RENDERSTATS_HPP__
+
+// STL Includes
+#include <vector>
+
+namespace SAGE
+{
+	// What the batches sent to the GPU, accumulated until the owner clears it (once per frame in Game).
+	struct RenderStats
+	{
+		int DrawCalls;
+		// Every quad the sprite batch drew, including lines, circle segments and triangles.
+		int Quads;
+		int Triangles;
+		int Vertices;
+		int UploadedBytes;
+		int TextureSwitches;
+		int StateChanges;
+		int CapacityFlushes;
+		int TextureFlushes;
+		float SortMilliseconds;
+
+		RenderStats()
+		{
+			Clear();
+		}
+
+		void Clear()
+		{
+			DrawCalls = 0;
+			Quads = 0;
+			Triangles = 0;
+			Vertices = 0;
+			UploadedBytes = 0;
+			TextureSwitches = 0;
+			StateChanges = 0;
+			CapacityFlushes = 0;
+			TextureFlushes = 0;
+			SortMilliseconds = 0.0f;
+		}
+
+		RenderStats& operator+=(const RenderStats& p_Other);
+	};
+
+	// Rolling minimum, average and maximum of each statistic over the last WindowSize frames.
+	class RenderStatsHistory
+	{
+		public:
+			static const int DefaultWindowSize = 120;
+
+			RenderStatsHistory(int p_WindowSize = DefaultWindowSize);
+			~RenderStatsHistory();
+
+			int GetWindowSize() const;
+			int GetFrameCount() const;
+			const RenderStats& GetLatest() const;
+			RenderStats GetMinimum() const;
+			RenderStats GetAverage() const;
+			RenderStats GetMaximum() const;
+
+			// Changing the window size discards the history.
+			void SetWindowSize(int p_WindowSize);
+			void Push(const RenderStats& p_Stats);
+			void Clear();
+
+		private:
+			int m_Next;
+			int m_FrameCount;
+			std::vector<RenderStats> m_Frames;
+	};
+}
+
+#endif
@@ -0,0 +1,66 @@
+// RenderThread.hpp
+
+#ifndef __SAGE_RENDERTHREAD_HPP__
+#define __SAGE_RENDERTHREAD_HPP__
+
+// SAGE Includes
+#include <SAGE/FramePacket.hpp>
+#include <SAGE/GeometryBatch.hpp>
+#include <SAGE/RenderStats.hpp>
+#include <SAGE/SpriteBatch.hpp>
+#include <SAGE/Window.hpp>
+// STL Includes
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace SAGE
+{
+	// Replays frame packets on a thread that owns the window's GL context, one frame behind the
+	// thread that records them. The recording thread gets a context sharing the window's objects,
+	// so textures and effects can still be created while running.
+	class RenderThread
+	{
+		private:
+			static const GLuint64 UploadWaitNanoseconds = 1000000000;
+
+		public:
+			RenderThread();
+			~RenderThread();
+
+			bool IsRunning() const;
+
+			// Statistics of the last packet the render thread finished.
+			const RenderStats& GetCompletedStats() const;
+
+			// Must be called on the thread that owns the window's context; that thread records from then on.
+			bool Start(Window* p_Window, const SpriteBatchOptions& p_Options = SpriteBatchOptions::DefaultOptions);
+			bool Stop();
+
+			// The packet to record the next frame into, already cleared.
+			FramePacket& AcquirePacket();
+			// Hands the acquired packet over, after waiting for the render thread to finish the previous one.
+			void SubmitPacket();
+
+		private:
+			void RenderMain();
+			void RenderPacket(FramePacket& p_Packet);
+
+			Window* m_Window;
+			SDL_GLContext m_RecordContext;
+			SpriteBatch m_SpriteBatch;
+			GeometryBatch m_GeometryBatch;
+			FramePacket m_Packets[2];
+			int m_WriteIndex;
+			RenderStats m_CompletedStats;
+			std::thread m_Thread;
+			std::mutex m_Mutex;
+			std::condition_variable m_Condition;
+			bool m_Running;
+			bool m_Rendering;
+			FramePacket* m_PendingPacket;
+			RenderStats m_RenderedStats;
+	};
+}
+
+#endif
@@ -5,10 +5,18 @@
 
 // SAGE Includes
 #include <SAGE/GeometryBatch.hpp>
+#include <SAGE/JobSystem.hpp>
 #include <SAGE/SpriteBatch.hpp>
+// STL Includes
+#include <atomic>
+#include <functional>
+#include <vector>
 
 namespace SAGE
 {
+	// GL work queued by Screen::Load; returns false on failure.
+	typedef std::function<bool()> ScreenUpload;
+
 	class ScreenManager;
 	class Screen
 	{
@@ -19,9 +27,15 @@ namespace SAGE
 			bool IsActive() const;
 			bool IsVisible() const;
 
+			// How much of Load has been reported done, from 0 to 1.
+			float GetLoadProgress() const;
+
 			void SetActive(bool p_Active);
 			void SetVisible(bool p_Visible);
 
+			// Runs on a job system worker before Initialize when the screen is pushed in the background.
+			// Only CPU-side work belongs here (reading files, Texture::Decode); GL work goes through QueueUpload.
+			virtual int Load();
 			virtual int Initialize();
 			virtual int Finalize();
 
@@ -41,10 +55,23 @@ namespace SAGE
 				Out,
 			};
 
+			// The owning game's job system, for spreading Update work across cores.
+			JobSystem* GetJobSystem() const;
+
+			// For use within Load. Uploads run in order on the main thread, a few per frame, before Initialize.
+			void QueueUpload(const ScreenUpload& p_Upload);
+			void SetLoadProgress(float p_Progress);
+
 			ScreenManager* m_Manager;
 			TransitionState m_TransitionState;
 			bool m_IsActive;
 			bool m_IsVisible;
+
+		private:
+			friend class ScreenManager;
+
+			std::atomic<float> m_LoadProgress;
+			std::vector<ScreenUpload> m_Uploads;
 	};
 }
 
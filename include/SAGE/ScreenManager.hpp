@@ -5,7 +5,10 @@
 
 // SAGE Includes
 #include <SAGE/IGameComponent.hpp>
+#include <SAGE/JobSystem.hpp>
 #include <SAGE/Screen.hpp>
+// SDL Includes
+#include <SDL2/SDL.h>
 // STL Includes
 #include <vector>
 
@@ -14,11 +17,24 @@ namespace SAGE
 	class ScreenManager : public IGameComponent
 	{
 		public:
+			static const Uint64 DefaultUploadNanoseconds = 2000000;
+
 			ScreenManager(Game* p_Game);
 			~ScreenManager();
 
 			bool IsEmpty() const;
-			int Push(Screen* p_Screen, bool p_Pause = true, bool p_Hide = true);
+			bool IsLoading() const;
+
+			// Progress of the screen being pushed in the background: Load covers the first half, its uploads the second.
+			float GetLoadProgress() const;
+			Uint64 GetUploadNanoseconds() const;
+
+			// How long each Update may spend running a loading screen's uploads; at least one runs per frame.
+			void SetUploadNanoseconds(Uint64 p_Nanoseconds);
+
+			// A background push runs the screen's Load on a worker and its uploads over the following frames,
+			// while the current screens keep updating. The screen joins the stack once Initialize succeeds.
+			int Push(Screen* p_Screen, bool p_Pause = true, bool p_Hide = true, bool p_Background = false);
 			int Pop();
 			int PopAll();
 
@@ -27,11 +43,20 @@ namespace SAGE
 			int Render(GeometryBatch& p_GeometryBatch);
 
 		private:
+			int ContinueLoading();
+			void CancelLoading();
+
 			std::vector<Screen*> m_Screens;
 			Screen* m_ScreenToPush;
 			bool m_PushPause;
 			bool m_PushHide;
+			bool m_PushBackground;
 			int m_PopCount;
+			bool m_Loading;
+			int m_LoadResult;
+			int m_UploadIndex;
+			Uint64 m_UploadNanoseconds;
+			JobCounter m_LoadCounter;
 	};
 }
 
@@ -9,8 +9,11 @@
 #include <SAGE/Effect.hpp>
 #include <SAGE/Orientation.hpp>
 #include <SAGE/Rectangle.hpp>
+#include <SAGE/RenderStats.hpp>
 #include <SAGE/SpriteFont.hpp>
+#include <SAGE/SpriteRecorder.hpp>
 #include <SAGE/Texture.hpp>
+#include <SAGE/UnitCircle.hpp>
 #include <SAGE/Vector2.hpp>
 #include <SAGE/VertexDefinitions.hpp>
 // STL Includes
@@ -42,30 +45,112 @@ namespace SAGE
 		CullCounterClockwise,
 	};
 
-	struct SpriteBatchItem
+	enum class BufferMode
 	{
-		unsigned int TextureID;
-		float Depth;
-		VertexPositionColorTexture VertexA;
-		VertexPositionColorTexture VertexB;
-		VertexPositionColorTexture VertexC;
+		Dynamic,
+		PersistentRing,
+	};
+
+	enum class VertexFormat
+	{
+		Full,
+		Packed,
+	};
+
+	class FramePacket;
+	struct SpritePass;
+
+	struct SpriteBatchOptions
+	{
+		static const BufferMode DefaultBufferMode;
+		static const VertexFormat DefaultVertexFormat;
+		static const bool DefaultInstancing;
+		static const int DefaultTextureSlots;
+		static const bool DefaultCulling;
+		static const bool DefaultTextCaching;
+
+		static const SpriteBatchOptions DefaultOptions;
+
+		BufferMode Buffering;
+		VertexFormat Format;
+		bool Instancing;
+		// Above one, runs only share textures when the effect passed to Begin reads each vertex's
+		// slot, as PositionColorTextureSlots does. Any other effect draws one texture per run.
+		int TextureSlots;
+		bool Culling;
+		bool TextCaching;
+
+		SpriteBatchOptions()
+		{
+			Buffering = DefaultBufferMode;
+			Format = DefaultVertexFormat;
+			Instancing = DefaultInstancing;
+			TextureSlots = DefaultTextureSlots;
+			Culling = DefaultCulling;
+			TextCaching = DefaultTextCaching;
+		}
+	};
+
+	struct SpriteBatchRun
+	{
+		int First;
+		int Length;
+		bool Instanced;
+		int TextureCount;
+		unsigned int TextureIDs[Effect::MaxTextureSlots];
+	};
+
+	struct SpriteBatchSortEntry
+	{
+		unsigned long long Key;
+		const SpriteRecorder* Recorder;
+		int Index;
 	};
 
 	class SpriteBatch
 	{
 		private:
 			static const int MaxBatchSize = 1024 * 10;
-			static const int MaxVertexCount = MaxBatchSize * 3;
-			static const int MaxIndexCount = MaxBatchSize * 3;
+			static const int MaxVertexCount = MaxBatchSize * 4;
+			static const int MaxIndexCount = MaxBatchSize * 6;
+			static const int RingSectionCount = 3;
 
 		public:
 			SpriteBatch();
 			~SpriteBatch();
 
 			int GetDrawCallCount() const;
+			BufferMode GetBufferMode() const;
+			VertexFormat GetVertexFormat() const;
+			bool IsInstancing() const;
+			int GetTextureSlots() const;
+			bool IsCulling() const;
+			bool IsTextCaching() const;
+			int GetSubmittedCount() const;
+			int GetCulledCount() const;
+			int GetUploadedByteCount() const;
+			const RenderStats& GetStats() const;
+			bool IsCapturing() const;
 
-			bool Initialize();
+			bool Initialize(const SpriteBatchOptions& p_Options = SpriteBatchOptions::DefaultOptions);
 			bool Finalize();
+			bool Trim();
+
+			// Statistics accumulate over every draw pair until reset.
+			void ResetStats();
+
+			// Call once per frame after the last draw pair. Every pair in a frame shares one ring
+			// section, which is fenced here and only waited on when the ring comes back around to it.
+			// Cached strings not drawn for a while are dropped here too.
+			void EndFrame();
+
+			// While a packet is set, draw pairs are recorded into it instead of reaching GL. Nothing
+			// is drawn until the packet is replayed through another batch, as RenderThread does.
+			bool SetCapture(FramePacket* p_Packet);
+
+			// Both take effect from the next Begin; the matching SpriteBatchOptions fields only set the initial values.
+			bool SetCulling(bool p_Culling);
+			bool SetTextCaching(bool p_TextCaching);
 
 			bool Begin(Effect& p_Effect, const Camera2D& p_Camera = Camera2D::DefaultCamera, SortMode p_SortMode = SortMode::None, BlendMode p_BlendMode = BlendMode::None, RasterizerState p_RasterizerState = RasterizerState::CullCounterClockwise);
 
@@ -74,12 +159,15 @@ namespace SAGE
 
 			bool DrawLines(const std::vector<Vector2>& p_Positions, const Color& p_Color, float p_Thickness = 1.0f, float p_Depth = 0.0f);
 			bool DrawLines(const std::vector<Vector2>& p_Positions, const std::vector<Color>& p_Colors, float p_Thickness = 1.0f, float p_Depth = 0.0f);
+			bool DrawLines(const Vector2* p_Positions, int p_PositionCount, const Color* p_Colors, int p_ColorCount, float p_Thickness = 1.0f, float p_Depth = 0.0f);
 
 			bool DrawLineLoop(const std::vector<Vector2>& p_Positions, const Color& p_Color, float p_Thickness = 1.0f, float p_Depth = 0.0f);
 			bool DrawLineLoop(const std::vector<Vector2>& p_Positions, const std::vector<Color>& p_Colors, float p_Thickness = 1.0f, float p_Depth = 0.0f);
+			bool DrawLineLoop(const Vector2* p_Positions, int p_PositionCount, const Color* p_Colors, int p_ColorCount, float p_Thickness = 1.0f, float p_Depth = 0.0f);
 
-			bool DrawCircle(const Vector2& p_Position, const Color& p_Color, float p_Radius, float p_Thickness = 1.0f, float p_Depth = 0.0f);
+			bool DrawCircle(const Vector2& p_Position, const Color& p_Color, float p_Radius, float p_Thickness = 1.0f, float p_Depth = 0.0f, const UnitCircle& p_Circle = UnitCircle::GetDefault());
 			bool DrawCircle(const Vector2& p_Position, const std::vector<Color>& p_Colors, float p_Radius, float p_Thickness = 1.0f, float p_Depth = 0.0f);
+			bool DrawCircle(const Vector2& p_Position, const Color* p_Colors, int p_ColorCount, float p_Radius, float p_Thickness = 1.0f, float p_Depth = 0.0f, const UnitCircle& p_Circle = UnitCircle::GetDefault());
 
 			bool DrawSolidTriangle(const Vector2 p_Positions[3], const Color& p_Color, float p_Depth = 0.0f);
 			bool DrawSolidTriangle(const Vector2 p_Positions[3], const Color p_Colors[3], float p_Depth = 0.0f);
@@ -88,36 +176,57 @@ namespace SAGE
 			bool DrawSolidRectangle(const Rectangle& p_Rectangle, const Color& p_Color, float p_Depth = 0.0f);
 			bool DrawSolidRectangle(const Vector2& p_Position, const Vector2& p_Dimensions, const Color& p_Color, float p_Depth = 0.0f);
 
-			bool DrawSolidCircle(const Vector2& p_Position, const Color& p_Color, float p_Radius, float p_Depth = 0.0f);
-			bool DrawSolidCircle(const Vector2& p_Position, const Color& p_ColorA, const Color& p_ColorB, float p_Radius, float p_Depth = 0.0f);
+			bool DrawSolidCircle(const Vector2& p_Position, const Color& p_Color, float p_Radius, float p_Depth = 0.0f, const UnitCircle& p_Circle = UnitCircle::GetDefault());
+			bool DrawSolidCircle(const Vector2& p_Position, const Color& p_ColorA, const Color& p_ColorB, float p_Radius, float p_Depth = 0.0f, const UnitCircle& p_Circle = UnitCircle::GetDefault());
 
 			bool DrawSprite(const Texture& p_Texture, const Vector2& p_Position, const Vector2& p_Dimensions, const Rectangle& p_SourceRectangle, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth = 0.0f);
 			bool DrawSprite(const Texture& p_Texture, const Vector2& p_Position, const Rectangle& p_DestinationRectangle, const Rectangle& p_SourceRectangle, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth = 0.0f);
 			bool DrawSprite(const Texture& p_Texture, const Rectangle& p_DestinationRectangle, const Rectangle& p_SourceRectangle, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth = 0.0f);
 			bool DrawSprite(const Texture& p_Texture, const Vector2& p_Position, const Rectangle& p_SourceRectangle, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth = 0.0f);
 
+			bool DrawSprites(const Texture& p_Texture, const SpriteDescriptors& p_Sprites);
+
 			bool DrawString(const SAGE::IFont* const p_Font, const std::string& p_String, const Vector2& p_Position, const Color& p_Color, float p_Depth = 0.0f);
 			bool DrawString(const SAGE::IFont* const p_Font, const std::string& p_String, const Vector2& p_Position, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth = 0.0f);
 
+			// Recorders pick up the current camera bounds when culling, so prepare them after Begin.
+			bool PrepareRecorder(SpriteRecorder& p_Recorder) const;
+			// Sorted pairs only read the recorder at End, so it must stay alive and unchanged until then,
+			// and may be submitted once per pair. Other pairs are done with it when this returns.
+			// Among equal sort keys, items drawn on the batch itself come first, then each recorder's
+			// items in the order the recorders were submitted, whatever order the calls interleaved in.
+			bool Submit(const SpriteRecorder& p_Recorder);
+
 			bool End();
 
 		private:
+			void Sort();
+			void RenderRecorder(const SpriteRecorder& p_Recorder);
+			void RenderSorted();
+			void FlushFullRecorder();
+			void ApplyRenderState();
 			void Render();
-			void Flush(int p_TextureID, int p_Length);
-
-			SpriteBatchItem& GetNextItem(const Texture& p_Texture, float p_Depth = 0.0f);
-			void SetVertexPosition(VertexPositionColorTexture& p_Vertex, float p_X, float p_Y);
-			void SetVertexColor(VertexPositionColorTexture& p_Vertex, const Color& p_Color);
-			void SetVertexTexCoords(VertexPositionColorTexture& p_Vertex, float p_U, float p_V);
-			void SetVertex(VertexPositionColorTexture& p_Vertex, float p_X, float p_Y, const Color& p_Color, float p_U, float p_V);
-			void TransformVerticesAbout(SpriteBatchItem& p_Item, const Vector2& p_Position, float p_CosAngle, float p_SinAngle, Orientation p_Orientation);
-			void RotateVerticesAbout(SpriteBatchItem& p_Item, const Vector2& p_Position, float p_CosAngle, float p_SinAngle);
-			void FlipVerticesAbout(SpriteBatchItem& p_Item, const Vector2& p_Position, Orientation p_Orientation);
-			void RotateVertexAbout(VertexPositionColorTexture& p_Vertex, const Vector2& p_Position, float p_CosAngle, float p_SinAngle);
-			void FlipVertexAbout(VertexPositionColorTexture& p_Vertex, const Vector2& p_Position, Orientation p_Orientation);
+			void RenderRange(int p_First, int p_Length);
+			void Flush(const SpriteBatchRun& p_Run);
+			void FlushInstances(const SpriteBatchRun& p_Run);
+			int GetRunTextureSlot(SpriteBatchRun& p_Run, unsigned int p_TextureID);
+
+			void* AcquireVertexSection(int p_Length);
+			void UploadVertexSection(int p_Length);
+			void ReleaseVertexSection(int p_Length);
+			void AdvanceVertexSection();
+			void GatherQuad(void* p_Section, int p_Index, const SpriteBatchItem& p_Item, unsigned int p_Slot);
+			void GatherVertex(unsigned char* p_Destination, const VertexPositionColorTexture& p_Vertex, unsigned int p_Slot);
+			void UploadInstances(int p_Length);
+
+			const SpriteBatchItem& GetSortedItem(int p_Position, const SpriteRecorder*& p_Recorder) const;
+			unsigned long long GetSortKey(const SpriteBatchItem& p_Item) const;
+			static unsigned int GetSortableDepth(float p_Depth);
+			static void RadixSort(std::vector<SpriteBatchSortEntry>& p_Entries, std::vector<SpriteBatchSortEntry>& p_Scratch, int p_Count);
+
+			void PackVertex(VertexPositionColorTexturePacked& p_Packed, const VertexPositionColorTexture& p_Vertex);
 
 			bool m_WithinDrawPair;
-			int m_ItemCount;
 			int m_FlushCount;
 			SortMode m_SortMode;
 			BlendMode m_BlendMode;
@@ -125,8 +234,44 @@ namespace SAGE
 			GLuint m_VertexArrayObject;
 			GLuint m_VertexBufferObject;
 			GLuint m_IndexBufferObject;
-			SpriteBatchItem m_BatchItemList[MaxBatchSize];
-			VertexPositionColorTexture m_VertexBuffer[MaxVertexCount];
+			BufferMode m_BufferMode;
+			VertexFormat m_VertexFormat;
+			GLsizei m_VertexStride;
+			int m_TextureSlots;
+			int m_RunTextureSlots;
+			unsigned char* m_MappedVertices;
+			GLsync m_SectionFences[RingSectionCount];
+			int m_SectionIndex;
+			int m_SectionOffset;
+			GLint m_RangeBaseVertex;
+			bool m_Instancing;
+			bool m_UsingInstanceEffect;
+			GLuint m_InstanceArrayObject;
+			GLuint m_InstanceBufferObject;
+			Effect* m_Effect;
+			Effect m_InstanceEffect;
+			glm::mat4 m_ProjectionMatrix;
+			glm::mat4 m_ModelViewMatrix;
+			std::vector<VertexSpriteInstance> m_InstanceBuffer;
+			std::vector<SpriteBatchRun> m_DrawRuns;
+			SpriteRecorder m_Recorder;
+			std::vector<const SpriteRecorder*> m_SubmittedRecorders;
+			const SpriteRecorder* m_RenderRecorder;
+			int m_RenderCount;
+			bool m_IsSorted;
+			bool m_Culling;
+			bool m_TextCaching;
+			Vector2 m_CullMinimum;
+			Vector2 m_CullMaximum;
+			int m_SubmittedCount;
+			int m_CulledCount;
+			int m_UploadedByteCount;
+			RenderStats m_Stats;
+			FramePacket* m_Capture;
+			SpritePass* m_CapturePass;
+			std::vector<SpriteBatchSortEntry> m_SortEntries;
+			std::vector<SpriteBatchSortEntry> m_SortScratch;
+			std::vector<unsigned char> m_VertexBuffer;
 			Texture m_BlankTexture;
 	};
 }
@@ -0,0 +1,205 @@
+// SpriteRecorder.hpp
+
+#ifndef __SAGE_SPRITERECORDER_HPP__
+#define __SAGE_SPRITERECORDER_HPP__
+
+// SAGE Includes
+#include <SAGE/Color.hpp>
+#include <SAGE/IFont.hpp>
+#include <SAGE/Orientation.hpp>
+#include <SAGE/Rectangle.hpp>
+#include <SAGE/Texture.hpp>
+#include <SAGE/UnitCircle.hpp>
+#include <SAGE/Vector2.hpp>
+#include <SAGE/VertexDefinitions.hpp>
+// STL Includes
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SAGE
+{
+	struct SpriteBatchItem
+	{
+		unsigned int TextureID;
+		float Depth;
+		int InstanceIndex;
+		VertexPositionColorTexture VertexA;
+		VertexPositionColorTexture VertexB;
+		VertexPositionColorTexture VertexC;
+		VertexPositionColorTexture VertexD;
+	};
+
+	// Glyph quads of one string laid out about the origin, keyed by everything that changes the layout.
+	struct TextMesh
+	{
+		const IFont* Font;
+		unsigned int TextureID;
+		std::string Text;
+		Vector2 Origin;
+		float Rotation;
+		Vector2 Scale;
+		Orientation Flip;
+		int LastUsedFrame;
+		Vector2 Minimum;
+		Vector2 Maximum;
+		std::vector<SpriteBatchItem> Quads;
+	};
+
+	// Structure-of-arrays description of sprites that share a texture. Only the positions are required;
+	// any other array left null uses the DrawSprite default (unit scale, no origin, rotation or flip, white, depth 0).
+	struct SpriteDescriptors
+	{
+		int Count;
+		const float* PositionX;
+		const float* PositionY;
+		const float* ScaleX;
+		const float* ScaleY;
+		const float* OriginX;
+		const float* OriginY;
+		const float* Rotation;
+		const float* Depth;
+		const Rectangle* SourceRectangles;
+		const Color* Colors;
+		const Orientation* Orientations;
+
+		SpriteDescriptors()
+		{
+			Count = 0;
+			PositionX = nullptr;
+			PositionY = nullptr;
+			ScaleX = nullptr;
+			ScaleY = nullptr;
+			OriginX = nullptr;
+			OriginY = nullptr;
+			Rotation = nullptr;
+			Depth = nullptr;
+			SourceRectangles = nullptr;
+			Colors = nullptr;
+			Orientations = nullptr;
+		}
+	};
+
+	// Records sprite geometry without touching GL, so any thread can fill its own recorder.
+	// A recorder is prepared by SpriteBatch::PrepareRecorder and drawn with SpriteBatch::Submit.
+	class SpriteRecorder
+	{
+		private:
+			static const int ItemPageSize = 1024;
+			static const int TextMeshLifetime = 120;
+			static const int MaxTextMeshCount = 256;
+
+		public:
+			SpriteRecorder();
+			~SpriteRecorder();
+
+			int GetItemCount() const;
+			int GetInstanceCount() const;
+			bool IsInstancing() const;
+			const SpriteBatchItem& GetItem(int p_Index) const;
+			const VertexSpriteInstance& GetInstance(int p_Index) const;
+			bool IsTextCaching() const;
+			int GetTextMeshCount() const;
+			bool IsCulling() const;
+			int GetSubmittedCount() const;
+			int GetCulledCount() const;
+
+			void Reset(unsigned int p_BlankTextureID, bool p_Instancing);
+			void Clear();
+			void Trim();
+
+			// Exchanges recorded items with another recorder; culling and cached strings stay where they are.
+			void Swap(SpriteRecorder& p_Other);
+			// Copies another recorder's items onto the end of this one.
+			void Append(const SpriteRecorder& p_Other);
+
+			// Primitives entirely outside the world-space bounds are rejected before any vertices are written.
+			void SetCullBounds(const Vector2& p_Minimum, const Vector2& p_Maximum);
+			void DisableCulling();
+
+			// Cached strings are rebuilt only when their font, text, origin, rotation, scale or orientation change.
+			// Strings that change every frame are cheaper uncached, so it is best kept for static text.
+			void SetTextCaching(bool p_Enabled);
+			// Ages cached strings, dropping any not drawn for a while. Call once per frame; SpriteBatch::EndFrame
+			// does so for the batch's own recorder.
+			void EndFrame();
+
+			bool DrawLine(const Vector2& p_PositionA, const Vector2& p_PositionB, const Color& p_Color, float p_Thickness = 1.0f, float p_Depth = 0.0f);
+			bool DrawLine(const Vector2& p_PositionA, const Color& p_ColorA, const Vector2& p_PositionB, const Color& p_ColorB, float p_Thickness = 1.0f, float p_Depth = 0.0f);
+
+			bool DrawLines(const std::vector<Vector2>& p_Positions, const Color& p_Color, float p_Thickness = 1.0f, float p_Depth = 0.0f);
+			bool DrawLines(const std::vector<Vector2>& p_Positions, const std::vector<Color>& p_Colors, float p_Thickness = 1.0f, float p_Depth = 0.0f);
+			bool DrawLines(const Vector2* p_Positions, int p_PositionCount, const Color* p_Colors, int p_ColorCount, float p_Thickness = 1.0f, float p_Depth = 0.0f);
+
+			bool DrawLineLoop(const std::vector<Vector2>& p_Positions, const Color& p_Color, float p_Thickness = 1.0f, float p_Depth = 0.0f);
+			bool DrawLineLoop(const std::vector<Vector2>& p_Positions, const std::vector<Color>& p_Colors, float p_Thickness = 1.0f, float p_Depth = 0.0f);
+			bool DrawLineLoop(const Vector2* p_Positions, int p_PositionCount, const Color* p_Colors, int p_ColorCount, float p_Thickness = 1.0f, float p_Depth = 0.0f);
+
+			bool DrawCircle(const Vector2& p_Position, const Color& p_Color, float p_Radius, float p_Thickness = 1.0f, float p_Depth = 0.0f, const UnitCircle& p_Circle = UnitCircle::GetDefault());
+			bool DrawCircle(const Vector2& p_Position, const std::vector<Color>& p_Colors, float p_Radius, float p_Thickness = 1.0f, float p_Depth = 0.0f);
+			bool DrawCircle(const Vector2& p_Position, const Color* p_Colors, int p_ColorCount, float p_Radius, float p_Thickness = 1.0f, float p_Depth = 0.0f, const UnitCircle& p_Circle = UnitCircle::GetDefault());
+
+			bool DrawSolidTriangle(const Vector2 p_Positions[3], const Color& p_Color, float p_Depth = 0.0f);
+			bool DrawSolidTriangle(const Vector2 p_Positions[3], const Color p_Colors[3], float p_Depth = 0.0f);
+
+			bool DrawSolidRectangle(float p_X, float p_Y, float p_Width, float p_Height, const Color& p_Color, float p_Depth = 0.0f);
+			bool DrawSolidRectangle(const Rectangle& p_Rectangle, const Color& p_Color, float p_Depth = 0.0f);
+			bool DrawSolidRectangle(const Vector2& p_Position, const Vector2& p_Dimensions, const Color& p_Color, float p_Depth = 0.0f);
+
+			bool DrawSolidCircle(const Vector2& p_Position, const Color& p_Color, float p_Radius, float p_Depth = 0.0f, const UnitCircle& p_Circle = UnitCircle::GetDefault());
+			bool DrawSolidCircle(const Vector2& p_Position, const Color& p_ColorA, const Color& p_ColorB, float p_Radius, float p_Depth = 0.0f, const UnitCircle& p_Circle = UnitCircle::GetDefault());
+
+			bool DrawSprite(const Texture& p_Texture, const Vector2& p_Position, const Vector2& p_Dimensions, const Rectangle& p_SourceRectangle, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth = 0.0f);
+			bool DrawSprite(const Texture& p_Texture, const Vector2& p_Position, const Rectangle& p_DestinationRectangle, const Rectangle& p_SourceRectangle, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth = 0.0f);
+			bool DrawSprite(const Texture& p_Texture, const Rectangle& p_DestinationRectangle, const Rectangle& p_SourceRectangle, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth = 0.0f);
+			bool DrawSprite(const Texture& p_Texture, const Vector2& p_Position, const Rectangle& p_SourceRectangle, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth = 0.0f);
+
+			bool DrawSprites(const Texture& p_Texture, const SpriteDescriptors& p_Sprites);
+
+			bool DrawString(const SAGE::IFont* const p_Font, const std::string& p_String, const Vector2& p_Position, const Color& p_Color, float p_Depth = 0.0f);
+			bool DrawString(const SAGE::IFont* const p_Font, const std::string& p_String, const Vector2& p_Position, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth = 0.0f);
+
+			static void PackColor(VertexColorPacked& p_Packed, float p_Red, float p_Green, float p_Blue, float p_Alpha);
+			static void PackTexCoord(VertexTexCoordPacked& p_Packed, float p_U, float p_V);
+
+		private:
+			bool Accept(float p_MinimumX, float p_MinimumY, float p_MaximumX, float p_MaximumY);
+			bool AcceptAbout(const Vector2& p_Position, float p_MinimumX, float p_MinimumY, float p_MaximumX, float p_MaximumY, bool p_Transformed);
+			bool DrawSpriteAt(const Texture& p_Texture, const SpriteDescriptors& p_Sprites, int p_Index);
+#if defined __SSE2__ || defined _M_X64
+			void DrawSpritesSSE(const Texture& p_Texture, const SpriteDescriptors& p_Sprites, int p_First);
+#endif
+			void LayoutString(const SAGE::IFont* const p_Font, const std::vector<std::string>& p_Lines, const Vector2& p_Position, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth, std::vector<SpriteBatchItem>* p_Quads);
+			const TextMesh& GetTextMesh(const SAGE::IFont* const p_Font, const std::string& p_String, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation);
+			void EvictTextMeshes();
+			SpriteBatchItem& GetNextItem(unsigned int p_TextureID, float p_Depth = 0.0f);
+			VertexSpriteInstance& GetNextInstance(unsigned int p_TextureID, float p_Depth = 0.0f);
+			void SetVertexPosition(VertexPositionColorTexture& p_Vertex, float p_X, float p_Y);
+			void SetVertexColor(VertexPositionColorTexture& p_Vertex, const Color& p_Color);
+			void SetVertexTexCoords(VertexPositionColorTexture& p_Vertex, float p_U, float p_V);
+			void SetVertex(VertexPositionColorTexture& p_Vertex, float p_X, float p_Y, const Color& p_Color, float p_U, float p_V);
+			void TransformVerticesAbout(SpriteBatchItem& p_Item, const Vector2& p_Position, float p_CosAngle, float p_SinAngle, Orientation p_Orientation);
+			void RotateVerticesAbout(SpriteBatchItem& p_Item, const Vector2& p_Position, float p_CosAngle, float p_SinAngle);
+			void FlipVerticesAbout(SpriteBatchItem& p_Item, const Vector2& p_Position, Orientation p_Orientation);
+			void RotateVertexAbout(VertexPositionColorTexture& p_Vertex, const Vector2& p_Position, float p_CosAngle, float p_SinAngle);
+			void FlipVertexAbout(VertexPositionColorTexture& p_Vertex, const Vector2& p_Position, Orientation p_Orientation);
+
+			unsigned int m_BlankTextureID;
+			bool m_Instancing;
+			int m_ItemCount;
+			int m_InstanceCount;
+			std::vector<std::vector<SpriteBatchItem>> m_ItemPages;
+			std::vector<VertexSpriteInstance> m_InstanceList;
+			bool m_Culling;
+			int m_CullSuspended;
+			int m_SubmittedCount;
+			int m_CulledCount;
+			Vector2 m_CullMinimum;
+			Vector2 m_CullMaximum;
+			bool m_TextCaching;
+			int m_FrameIndex;
+			std::unordered_multimap<size_t, TextMesh> m_TextMeshes;
+	};
+}
+
+#endif
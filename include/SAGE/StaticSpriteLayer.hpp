@@ -0,0 +1,58 @@
+// StaticSpriteLayer.hpp
+
+#ifndef __SAGE_STATICSPRITELAYER_HPP__
+#define __SAGE_STATICSPRITELAYER_HPP__
+
+// SAGE Includes
+#include <SAGE/Camera2D.hpp>
+#include <SAGE/Effect.hpp>
+#include <SAGE/SpriteBatch.hpp>
+#include <SAGE/SpriteRecorder.hpp>
+#include <SAGE/Texture.hpp>
+// STL Includes
+#include <vector>
+
+namespace SAGE
+{
+	struct StaticSpriteGroup
+	{
+		unsigned int TextureID;
+		int FirstIndex;
+		int IndexCount;
+	};
+
+	// Sprites that never move, baked once into static buffers and drawn with one call per texture.
+	// Sprites are recorded through Edit() with the SpriteBatch draw API; the layer rebuilds on the next Draw after an edit.
+	class StaticSpriteLayer
+	{
+		public:
+			StaticSpriteLayer();
+			~StaticSpriteLayer();
+
+			int GetDrawCallCount() const;
+			int GetSpriteCount() const;
+			bool IsDirty() const;
+
+			bool Initialize();
+			bool Finalize();
+
+			SpriteRecorder& Edit();
+			void Clear();
+
+			bool Draw(Effect& p_Effect, const Camera2D& p_Camera = Camera2D::DefaultCamera, BlendMode p_BlendMode = BlendMode::None, RasterizerState p_RasterizerState = RasterizerState::CullCounterClockwise);
+
+		private:
+			bool Rebuild();
+
+			bool m_IsDirty;
+			int m_FlushCount;
+			GLuint m_VertexArrayObject;
+			GLuint m_VertexBufferObject;
+			GLuint m_IndexBufferObject;
+			SpriteRecorder m_Recorder;
+			std::vector<StaticSpriteGroup> m_Groups;
+			Texture m_BlankTexture;
+	};
+}
+
+#endif
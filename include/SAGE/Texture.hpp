@@ -13,6 +13,7 @@
 #include <SAGE/Color.hpp>
 #include <SAGE/Surface.hpp>
 // STL Includes
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -32,29 +33,59 @@ namespace SAGE
 		ClampToBorder,
 	};
 
+	class TextureStreamer;
+
 	class Texture
 	{
 		public:
 			Texture();
 			~Texture();
 
+			// Bytes held by every texture: retained and decoded pixels on the CPU, texture storage on the GPU.
+			static Uint64 GetCPUByteCount();
+			static Uint64 GetGPUByteCount();
+
 			unsigned int GetID() const;
 			unsigned int GetWidth() const;
 			unsigned int GetHeight() const;
 			unsigned int GetBytesPerPixel() const;
 			Interpolation GetInterpolation() const;
 			Wrapping GetWrapping() const;
+			bool IsStreaming() const;
+			bool IsRetainingPixels() const;
+			// Only available when pixels were retained at load time.
 			bool GetPixelColor(unsigned int p_X, unsigned int p_Y, Color& p_Color);
 
+			// Keeps a four byte per pixel copy for GetPixelColor; must be set before loading. Clearing it
+			// releases a copy already kept.
+			void SetRetainPixels(bool p_Retain);
+
 			bool FromPixelColors(unsigned int p_Width, unsigned int p_Height, std::vector<Color> p_Colors, Interpolation p_Interpolation = Interpolation::Linear, Wrapping p_Wrapping = Wrapping::Repeat);
 			bool Load(const std::string& p_Filename, Interpolation p_Interpolation = Interpolation::Linear, Wrapping p_Wrapping = Wrapping::Repeat);
 			bool Unload();
 
+			// Load in two halves: Decode reads the image without touching GL, so it can run on any thread,
+			// and Upload creates the texture from it on the thread that owns the GL context.
+			bool Decode(const std::string& p_Filename, Interpolation p_Interpolation = Interpolation::Linear, Wrapping p_Wrapping = Wrapping::Repeat);
+			bool Upload();
+
+			// Decodes on a worker and uploads through p_Streamer over the following frames. Until then the
+			// ID is the streamer's placeholder, and the size reads as zero until decoding has finished.
+			bool LoadAsync(TextureStreamer& p_Streamer, const std::string& p_Filename, Interpolation p_Interpolation = Interpolation::Linear, Wrapping p_Wrapping = Wrapping::Repeat);
+
 		private:
+			friend class TextureStreamer;
+
 			bool CreateFromPixelData(void* p_PixelData);
-			bool ReadColorDataFromSurface(SDL_Surface* p_Surface, unsigned int p_X, unsigned int p_Y, Uint32& p_Pixel, Color& p_Color);
+			bool ReadPixelFromSurface(SDL_Surface* p_Surface, unsigned int p_X, unsigned int p_Y, Uint32& p_Pixel);
+			void FreeDecodedSurface();
+			void AccountMemory(Uint64 p_CPUBytes, Uint64 p_GPUBytes);
+
+			static std::atomic<Uint64> sCPUByteCount;
+			static std::atomic<Uint64> sGPUByteCount;
 
 			bool m_IsLoaded;
+			bool m_RetainPixels;
 			unsigned int m_ID;
 			unsigned int m_Width;
 			unsigned int m_Height;
@@ -62,7 +93,10 @@ namespace SAGE
 			Interpolation m_Interpolation;
 			Wrapping m_Wrapping;
 			std::vector<Uint32> m_Pixels;
-			std::vector<Color> m_Colors;
+			SDL_Surface* m_DecodedSurface;
+			Uint64 m_CPUByteCount;
+			Uint64 m_GPUByteCount;
+			TextureStreamer* m_Streamer;
 	};
 }
 
@@ -0,0 +1,97 @@
+// TextureStreamer.hpp
+
+#ifndef __SAGE_TEXTURESTREAMER_HPP__
+#define __SAGE_TEXTURESTREAMER_HPP__
+
+// SAGE Includes
+#include <SAGE/Color.hpp>
+#include <SAGE/JobSystem.hpp>
+#include <SAGE/Texture.hpp>
+// STL Includes
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SAGE
+{
+	struct TextureStreamerOptions
+	{
+		static const int DefaultBytesPerFrame;
+		static const Color DefaultPlaceholderColor;
+
+		static const TextureStreamerOptions DefaultOptions;
+
+		int BytesPerFrame;
+		Color PlaceholderColor;
+
+		TextureStreamerOptions()
+		{
+			BytesPerFrame = DefaultBytesPerFrame;
+			PlaceholderColor = DefaultPlaceholderColor;
+		}
+	};
+
+	// Loads textures without stalling the frame. Images are decoded on job system workers, then
+	// copied a few rows at a time through a pixel unpack buffer, at most BytesPerFrame per Update.
+	class TextureStreamer
+	{
+		public:
+			TextureStreamer();
+			~TextureStreamer();
+
+			unsigned int GetPlaceholderID() const;
+			int GetBytesPerFrame() const;
+			int GetPendingCount() const;
+			int GetUploadedByteCount() const;
+
+			bool Initialize(JobSystem* p_JobSystem, const TextureStreamerOptions& p_Options = TextureStreamerOptions::DefaultOptions);
+			bool Finalize();
+
+			// At least one row is uploaded per frame, however small the budget.
+			void SetBytesPerFrame(int p_Bytes);
+
+			// Used by Texture::LoadAsync and when a streaming texture is unloaded or destroyed.
+			bool Request(Texture& p_Texture, const std::string& p_Filename, Interpolation p_Interpolation, Wrapping p_Wrapping);
+			void Cancel(Texture& p_Texture);
+
+			// Call once per frame on the thread that owns the GL context.
+			void Update();
+
+		private:
+			struct StreamRequest
+			{
+				Texture* Target;
+				std::string Filename;
+				Interpolation Filter;
+				Wrapping Wrap;
+				Texture Staging;
+				JobCounter Decoded;
+				bool Failed;
+				bool Allocated;
+				int RowsUploaded;
+			};
+
+			struct StreamChunk
+			{
+				StreamRequest* Request;
+				int FirstRow;
+				int RowCount;
+				int Offset;
+			};
+
+			bool Allocate(StreamRequest& p_Request);
+			void UploadChunks(int p_Size);
+			void Complete(StreamRequest& p_Request);
+			void Discard(StreamRequest& p_Request);
+
+			JobSystem* m_JobSystem;
+			int m_BytesPerFrame;
+			int m_UploadedByteCount;
+			GLuint m_PixelBuffer;
+			Texture m_Placeholder;
+			std::vector<std::unique_ptr<StreamRequest>> m_Requests;
+			std::vector<StreamChunk> m_Chunks;
+	};
+}
+
+#endif
@@ -8,6 +8,7 @@
 
 namespace SAGE
 {
+	// Measures time with the performance counter, so deltas keep sub-millisecond precision.
 	class Timer
 	{
 		public:
@@ -15,7 +16,9 @@ namespace SAGE
 			~Timer();
 
 			float GetDeltaTime();
+			Uint64 GetDeltaNanoseconds();
 			float GetElapsedTime() const;
+			Uint64 GetElapsedNanoseconds() const;
 			int GetTicks() const;
 
 			void Start();
@@ -23,10 +26,12 @@ namespace SAGE
 			void Pause();
 			void Resume();
 
+			static Uint64 GetNanoseconds(Uint64 p_Counts);
+
 		private:
-			Uint32 m_StartTicks;
-			Uint32 m_LastTicks;
-			Uint32 m_PausedTicks;
+			Uint64 m_StartCount;
+			Uint64 m_LastCount;
+			Uint64 m_PausedCount;
 			bool m_Started;
 			bool m_Paused;
 	};
@@ -0,0 +1,38 @@
+// UnitCircle.hpp
+
+#ifndef __SAGE_UNITCIRCLE_HPP__
+#define __SAGE_UNITCIRCLE_HPP__
+
+// SAGE Includes
+#include <SAGE/Vector2.hpp>
+// STL Includes
+#include <vector>
+
+namespace SAGE
+{
+	// Precomputed points around the unit circle so circles can be drawn without trigonometry or allocations.
+	// Holds SegmentCount + 1 points; the last one repeats the first so segment i always runs from point i to i + 1.
+	class UnitCircle
+	{
+		public:
+			static const int DefaultSegmentCount = 32;
+
+			UnitCircle(int p_SegmentCount = DefaultSegmentCount);
+			~UnitCircle();
+
+			int GetSegmentCount() const;
+			const Vector2* GetPoints() const;
+
+			// Storage is only reallocated when the table grows.
+			void SetSegmentCount(int p_SegmentCount);
+
+			// Shared default table, safe to read from any thread.
+			static const UnitCircle& GetDefault();
+
+		private:
+			int m_SegmentCount;
+			std::vector<Vector2> m_Points;
+	};
+}
+
+#endif
@@ -19,6 +19,20 @@ namespace SAGE
 		float A;
 	};
 
+	struct VertexColorPacked
+	{
+		unsigned char R;
+		unsigned char G;
+		unsigned char B;
+		unsigned char A;
+	};
+
+	struct VertexTexCoordPacked
+	{
+		unsigned short U;
+		unsigned short V;
+	};
+
 	struct VertexPositionColor
 	{
 		VertexVector2 Position;
@@ -31,6 +45,25 @@ namespace SAGE
 		VertexColor Color;
 		VertexVector2 TexCoord;
 	};
+
+	struct VertexPositionColorTexturePacked
+	{
+		VertexVector2 Position;
+		VertexColorPacked Color;
+		VertexTexCoordPacked TexCoord;
+	};
+
+	struct VertexSpriteInstance
+	{
+		VertexVector2 Position;
+		VertexVector2 Size;
+		VertexVector2 Origin;
+		float Rotation;
+		VertexTexCoordPacked TexCoordMin;
+		VertexTexCoordPacked TexCoordMax;
+		VertexColorPacked Color;
+		unsigned int Flags;
+	};
 }
 
 #endif
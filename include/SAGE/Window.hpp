@@ -120,6 +120,7 @@ namespace SAGE
 			~Window();
 
 			SDL_Window* GetC() const;
+			SDL_GLContext GetContext() const;
 
 			bool Initialize(const WindowOptions& p_Options = WindowOptions::DefaultOptions);
 			bool Reinitialize(const WindowOptions& p_Options = WindowOptions::DefaultOptions);
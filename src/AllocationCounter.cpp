@@ -0,0 +1,88 @@
+// AllocationCounter.cpp
+
+// SAGE Includes
+#include <SAGE/AllocationCounter.hpp>
+// STL Includes
+#if defined SAGE_TRACK_ALLOCATIONS
+	#include <atomic>
+	#include <cstdlib>
+	#include <new>
+#endif
+
+#if defined SAGE_TRACK_ALLOCATIONS
+namespace
+{
+	std::atomic<long long> sAllocationCount(0);
+	std::atomic<long long> sAllocatedBytes(0);
+
+	void* CountedAllocate(std::size_t p_Size)
+	{
+		sAllocationCount++;
+		sAllocatedBytes += static_cast<long long>(p_Size);
+
+		void* pointer = std::malloc(p_Size == 0 ? 1 : p_Size);
+		if (pointer == nullptr)
+			throw std::bad_alloc();
+
+		return pointer;
+	}
+}
+
+void* operator new(std::size_t p_Size)
+{
+	return CountedAllocate(p_Size);
+}
+
+void* operator new[](std::size_t p_Size)
+{
+	return CountedAllocate(p_Size);
+}
+
+void operator delete(void* p_Pointer) noexcept
+{
+	std::free(p_Pointer);
+}
+
+void operator delete[](void* p_Pointer) noexcept
+{
+	std::free(p_Pointer);
+}
+#endif
+
+namespace SAGE
+{
+	bool AllocationCounter::IsEnabled()
+	{
+#if defined SAGE_TRACK_ALLOCATIONS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	long long AllocationCounter::GetAllocationCount()
+	{
+#if defined SAGE_TRACK_ALLOCATIONS
+		return sAllocationCount.load();
+#else
+		return 0;
+#endif
+	}
+
+	long long AllocationCounter::GetAllocatedBytes()
+	{
+#if defined SAGE_TRACK_ALLOCATIONS
+		return sAllocatedBytes.load();
+#else
+		return 0;
+#endif
+	}
+
+	void AllocationCounter::Reset()
+	{
+#if defined SAGE_TRACK_ALLOCATIONS
+		sAllocationCount = 0;
+		sAllocatedBytes = 0;
+#endif
+	}
+}
@@ -2,6 +2,9 @@
 
 // SAGE Includes
 #include <SAGE/Camera2D.hpp>
+// STL Includes
+#include <algorithm>
+#include <cmath>
 
 namespace SAGE
 {
@@ -125,9 +128,48 @@ namespace SAGE
 
 	void Camera2D::ScreenToWorld(const Vector2& p_ScreenPosition, Vector2& p_WorldPosition) const
 	{
+		// Undo the model view: recenter, unscale, unrotate, then move back to the camera position.
+		float x = (p_ScreenPosition.X - (float)m_Width / 2.0f) / m_Scale.X;
+		float y = (p_ScreenPosition.Y - (float)m_Height / 2.0f) / m_Scale.Y;
+
+		float cosAngle = cosf(m_Rotation);
+		float sinAngle = sinf(m_Rotation);
+
+		p_WorldPosition.X = x * cosAngle + y * sinAngle + m_Position.X;
+		p_WorldPosition.Y = -x * sinAngle + y * cosAngle + m_Position.Y;
 	}
 
 	void Camera2D::WorldToScreen(const Vector2& p_WorldPosition, Vector2& p_ScreenPosition) const
 	{
+		// Same transformation as the model view matrix.
+		float x = p_WorldPosition.X - m_Position.X;
+		float y = p_WorldPosition.Y - m_Position.Y;
+
+		float cosAngle = cosf(m_Rotation);
+		float sinAngle = sinf(m_Rotation);
+
+		p_ScreenPosition.X = (x * cosAngle - y * sinAngle) * m_Scale.X + (float)m_Width / 2.0f;
+		p_ScreenPosition.Y = (x * sinAngle + y * cosAngle) * m_Scale.Y + (float)m_Height / 2.0f;
+	}
+
+	void Camera2D::GetWorldBounds(Vector2& p_Minimum, Vector2& p_Maximum) const
+	{
+		// Axis-aligned box around the four screen corners in world space.
+		Vector2 corners[4];
+		ScreenToWorld(Vector2(0.0f, 0.0f), corners[0]);
+		ScreenToWorld(Vector2((float)m_Width, 0.0f), corners[1]);
+		ScreenToWorld(Vector2(0.0f, (float)m_Height), corners[2]);
+		ScreenToWorld(Vector2((float)m_Width, (float)m_Height), corners[3]);
+
+		p_Minimum = corners[0];
+		p_Maximum = corners[0];
+
+		for (int i = 1; i < 4; ++i)
+		{
+			p_Minimum.X = std::min(p_Minimum.X, corners[i].X);
+			p_Minimum.Y = std::min(p_Minimum.Y, corners[i].Y);
+			p_Maximum.X = std::max(p_Maximum.X, corners[i].X);
+			p_Maximum.Y = std::max(p_Maximum.Y, corners[i].Y);
+		}
 	}
 }
@@ -4,6 +4,8 @@
 #include <SDL2/SDL.h>
 // SAGE Includes
 #include <SAGE/Effect.hpp>
+#include <SAGE/IRenderDevice.hpp>
+#include <SAGE/RenderState.hpp>
 // STL Includes
 #include <iostream>
 #include <fstream>
@@ -76,8 +78,98 @@ namespace SAGE
 		"	out_Color = texture(uTextureSampler, pass_TexCoord) * pass_Color;\n"
 		"}";
 
+	const std::string Effect::SpriteInstanceVertexSource =
+#if defined __ANDROID__
+		"#version 300 es\n\n"
+#else
+		"#version 330 core\n\n"
+#endif
+		"uniform mat4 uProjectionMatrix;\n"
+		"uniform mat4 uModelViewMatrix;\n\n"
+		"layout(location = 0) in vec2 in_Position;\n"
+		"layout(location = 1) in vec2 in_Size;\n"
+		"layout(location = 2) in vec2 in_Origin;\n"
+		"layout(location = 3) in float in_Rotation;\n"
+		"layout(location = 4) in vec4 in_TexCoords;\n"
+		"layout(location = 5) in vec4 in_Color;\n"
+		"layout(location = 6) in uint in_Flags;\n\n"
+		"out vec4 pass_Color;\n"
+		"out vec2 pass_TexCoord;\n\n"
+		"void main()\n"
+		"{\n"
+		"	vec2 corner = vec2(float(gl_VertexID >> 1), float(gl_VertexID & 1));\n"
+		"	vec2 local = corner * in_Size - in_Origin;\n"
+		"	float cosAngle = cos(in_Rotation);\n"
+		"	float sinAngle = sin(in_Rotation);\n"
+		"	vec2 position = in_Position + vec2(local.x * cosAngle - local.y * sinAngle, local.x * sinAngle + local.y * cosAngle);\n\n"
+		"	vec2 texCoord = mix(in_TexCoords.xy, in_TexCoords.zw, corner);\n"
+		"	if ((in_Flags & 2u) != 0u)\n"
+		"		texCoord.x = in_TexCoords.x + in_TexCoords.z - texCoord.x;\n"
+		"	if ((in_Flags & 4u) != 0u)\n"
+		"		texCoord.y = in_TexCoords.y + in_TexCoords.w - texCoord.y;\n\n"
+		"	pass_Color = in_Color;\n"
+		"	pass_TexCoord = texCoord;\n\n"
+		"	gl_Position = uProjectionMatrix * uModelViewMatrix * vec4(position, 1.0, 1.0);\n"
+		"}";
+
+	const std::string Effect::PositionColorTextureSlotsVertexSource =
+#if defined __ANDROID__
+		"#version 300 es\n\n"
+#else
+		"#version 330 core\n\n"
+#endif
+		"uniform mat4 uProjectionMatrix;\n"
+		"uniform mat4 uModelViewMatrix;\n\n"
+		"layout(location = 0) in vec2 in_Position;\n"
+		"layout(location = 1) in vec4 in_Color;\n"
+		"layout(location = 2) in vec2 in_TexCoord;\n"
+		"layout(location = 3) in uint in_TextureSlot;\n\n"
+		"out vec4 pass_Color;\n"
+		"out vec2 pass_TexCoord;\n"
+		"flat out uint pass_TextureSlot;\n\n"
+		"void main()\n"
+		"{\n"
+		"	pass_Color = in_Color;\n"
+		"	pass_TexCoord = in_TexCoord;\n"
+		"	pass_TextureSlot = in_TextureSlot;\n\n"
+		"	gl_Position = uProjectionMatrix * uModelViewMatrix * vec4(in_Position, 1.0, 1.0);\n"
+		"}";
+
+	const std::string Effect::PositionColorTextureSlotsFragmentSource =
+#if defined __ANDROID__
+		"#version 300 es\n\n"
+#else
+		"#version 330 core\n\n"
+#endif
+		"uniform sampler2D uTextureSamplers[8];\n\n"
+		"in vec4 pass_Color;\n"
+		"in vec2 pass_TexCoord;\n"
+		"flat in uint pass_TextureSlot;\n\n"
+		"out vec4 out_Color;\n\n"
+		"void main()\n"
+		"{\n"
+		"	vec4 sampled = vec4(1.0);\n\n"
+		"	// Sampler arrays may only be indexed with constants here.\n"
+		"	switch (pass_TextureSlot)\n"
+		"	{\n"
+		"		case 0u: sampled = texture(uTextureSamplers[0], pass_TexCoord); break;\n"
+		"		case 1u: sampled = texture(uTextureSamplers[1], pass_TexCoord); break;\n"
+		"		case 2u: sampled = texture(uTextureSamplers[2], pass_TexCoord); break;\n"
+		"		case 3u: sampled = texture(uTextureSamplers[3], pass_TexCoord); break;\n"
+		"		case 4u: sampled = texture(uTextureSamplers[4], pass_TexCoord); break;\n"
+		"		case 5u: sampled = texture(uTextureSamplers[5], pass_TexCoord); break;\n"
+		"		case 6u: sampled = texture(uTextureSamplers[6], pass_TexCoord); break;\n"
+		"		case 7u: sampled = texture(uTextureSamplers[7], pass_TexCoord); break;\n"
+		"	}\n\n"
+		"	out_Color = sampled * pass_Color;\n"
+		"}";
+
 	Effect::Effect()
 	{
+		m_Program = 0;
+		m_ReadsTextureSlots = false;
+		m_ProjectionMatrixLocation = -1;
+		m_ModelViewMatrixLocation = -1;
 	}
 
 	Effect::~Effect()
@@ -109,22 +201,57 @@ namespace SAGE
 					return false;
 				SetUniform("uTextureSampler", 0);
 				return true;
+			case BasicType::SpriteInstance:
+				if (!Attach(SpriteInstanceVertexSource, ShaderType::Vertex))
+					return false;
+				if (!Attach(PositionColorTextureFragmentSource, ShaderType::Fragment))
+					return false;
+				if (!Link())
+					return false;
+				Use();
+				SetUniform("uTextureSampler", 0);
+				return true;
+			case BasicType::PositionColorTextureSlots:
+				if (!Attach(PositionColorTextureSlotsVertexSource, ShaderType::Vertex))
+					return false;
+				if (!Attach(PositionColorTextureSlotsFragmentSource, ShaderType::Fragment))
+					return false;
+				if (!Link())
+					return false;
+				Use();
+				for (int i = 0; i < MaxTextureSlots; ++i)
+				{
+					SetUniform("uTextureSamplers[" + std::to_string(i) + "]", i);
+				}
+				m_ReadsTextureSlots = true;
+				return true;
 		}
 
 		return false;
 	}
 
+	bool Effect::ReadsTextureSlots() const
+	{
+		return m_ReadsTextureSlots;
+	}
+
 	bool Effect::Initialize()
 	{
-		m_Program = glCreateProgram();
+		m_Program = IRenderDevice::Get().CreateProgram();
+		m_ReadsTextureSlots = false;
 
 		return true;
 	}
 
 	bool Effect::Finalize()
 	{
-		glUseProgram(0);
-		glDeleteProgram(m_Program);
+		if (m_Program == 0)
+			return true;
+
+		RenderState::UseProgram(0);
+		IRenderDevice::Get().DeleteProgram(m_Program);
+
+		m_Program = 0;
 
 		return true;
 	}
@@ -134,15 +261,15 @@ namespace SAGE
 		const GLchar* source = p_Source.c_str();
 
 		GLint status;
-		GLuint shader = glCreateShader(p_Type);
-		glShaderSource(shader, 1, &source, NULL);
-		glCompileShader(shader);
-		glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+		GLuint shader = IRenderDevice::Get().CreateShader(p_Type);
+		IRenderDevice::Get().ShaderSource(shader, 1, &source, NULL);
+		IRenderDevice::Get().CompileShader(shader);
+		IRenderDevice::Get().GetShaderiv(shader, GL_COMPILE_STATUS, &status);
 		if (status != GL_TRUE)
 		{
 			GLint length = 0;
 			GLchar message[256];
-			glGetShaderInfoLog(shader, length, &length, message);
+			IRenderDevice::Get().GetShaderInfoLog(shader, length, &length, message);
 
 			SDL_Log("[Effect::Attach] Error compiling shader: %s", message);
 
@@ -150,10 +277,10 @@ namespace SAGE
 		}
 		else
 		{
-			glAttachShader(m_Program, shader);
+			IRenderDevice::Get().AttachShader(m_Program, shader);
 		}
 
-		glDeleteShader(shader);
+		IRenderDevice::Get().DeleteShader(shader);
 
 		return true;
 	}
@@ -176,14 +303,14 @@ namespace SAGE
 	{
 		GLint linked = GL_FALSE;
 
-		glLinkProgram(m_Program);
-		glGetProgramiv(m_Program, GL_LINK_STATUS, &linked);
+		IRenderDevice::Get().LinkProgram(m_Program);
+		IRenderDevice::Get().GetProgramiv(m_Program, GL_LINK_STATUS, &linked);
 		if (linked != GL_TRUE)
 		{
 			GLsizei length = 0;
-			glGetProgramiv(m_Program, GL_INFO_LOG_LENGTH, &length);
+			IRenderDevice::Get().GetProgramiv(m_Program, GL_INFO_LOG_LENGTH, &length);
 			GLchar* message = new GLchar[length + 1];
-			glGetProgramInfoLog(m_Program, length, &length, message);
+			IRenderDevice::Get().GetProgramInfoLog(m_Program, length, &length, message);
 
 			SDL_Log("[Effect::Link] Shader linking failed: %s", message);
 			delete [] message;
@@ -192,28 +319,28 @@ namespace SAGE
 		}
 
 		// TODO: Make matrix acquisition more dynamic.
-		m_ProjectionMatrixLocation = glGetUniformLocation(m_Program, "uProjectionMatrix");
-		m_ModelViewMatrixLocation = glGetUniformLocation(m_Program, "uModelViewMatrix");
+		m_ProjectionMatrixLocation = IRenderDevice::Get().GetUniformLocation(m_Program, "uProjectionMatrix");
+		m_ModelViewMatrixLocation = IRenderDevice::Get().GetUniformLocation(m_Program, "uModelViewMatrix");
 
 		return true;
 	}
 
 	void Effect::Use()
 	{
-		glUseProgram(m_Program);
+		RenderState::UseProgram(m_Program);
 	}
 
 	void Effect::PrintUniforms()
 	{
 		GLint total;
-		glGetProgramiv(m_Program, GL_ACTIVE_UNIFORMS, &total);
+		IRenderDevice::Get().GetProgramiv(m_Program, GL_ACTIVE_UNIFORMS, &total);
 		for (GLint i = 0; i < total; i++)
 		{
 			int number = 0;
 			int length = 0;
 			GLenum type = GL_ZERO;
 			char name[128];
-			glGetActiveUniform(m_Program, i, 127, &length, &number, &type, name);
+			IRenderDevice::Get().GetActiveUniform(m_Program, i, 127, &length, &number, &type, name);
 			name[length] = 0;
 
 			std::cout << "Uniform #" << (i + 1) << ": " << name << std::endl;
@@ -222,36 +349,36 @@ namespace SAGE
 
 	GLint Effect::GetUniform(const std::string& p_Name)
 	{
-		return glGetUniformLocation(m_Program, p_Name.c_str());
+		return IRenderDevice::Get().GetUniformLocation(m_Program, p_Name.c_str());
 	}
 
 	void Effect::SetProjection(const glm::mat4& p_Matrix)
 	{
-		glUniformMatrix4fv(m_ProjectionMatrixLocation, 1, GL_FALSE, glm::value_ptr(p_Matrix));
+		IRenderDevice::Get().UniformMatrix4fv(m_ProjectionMatrixLocation, 1, GL_FALSE, glm::value_ptr(p_Matrix));
 	}
 
 	void Effect::SetModelView(const glm::mat4& p_Matrix)
 	{
-		glUniformMatrix4fv(m_ModelViewMatrixLocation, 1, GL_FALSE, glm::value_ptr(p_Matrix));
+		IRenderDevice::Get().UniformMatrix4fv(m_ModelViewMatrixLocation, 1, GL_FALSE, glm::value_ptr(p_Matrix));
 	}
 
 	void Effect::SetUniform(const std::string& p_Name, int p_Value)
 	{
 		if (m_Uniforms.find(p_Name) == m_Uniforms.end())
 		{
-			m_Uniforms[p_Name] = glGetUniformLocation(m_Program, p_Name.c_str());
+			m_Uniforms[p_Name] = IRenderDevice::Get().GetUniformLocation(m_Program, p_Name.c_str());
 		}
 
-		glUniform1i(m_Uniforms[p_Name], p_Value);
+		IRenderDevice::Get().Uniform1i(m_Uniforms[p_Name], p_Value);
 	}
 
 	void Effect::SetUniform(const std::string& p_Name, float p_Value)
 	{
 		if (m_Uniforms.find(p_Name) == m_Uniforms.end())
 		{
-			m_Uniforms[p_Name] = glGetUniformLocation(m_Program, p_Name.c_str());
+			m_Uniforms[p_Name] = IRenderDevice::Get().GetUniformLocation(m_Program, p_Name.c_str());
 		}
 
-		glUniform1f(m_Uniforms[p_Name], p_Value);
+		IRenderDevice::Get().Uniform1f(m_Uniforms[p_Name], p_Value);
 	}
 }
@@ -0,0 +1,174 @@
+// FrameLimiter.cpp
+
+// SAGE Includes
+#include <SAGE/FrameLimiter.hpp>
+// STL Includes
+#include <algorithm>
+#include <cmath>
+
+namespace SAGE
+{
+	FrameTimeHistory::FrameTimeHistory(int p_WindowSize)
+	{
+		m_Next = 0;
+		m_FrameCount = 0;
+
+		SetWindowSize(p_WindowSize);
+	}
+
+	FrameTimeHistory::~FrameTimeHistory()
+	{
+	}
+
+	int FrameTimeHistory::GetWindowSize() const
+	{
+		return (int)m_Frames.size();
+	}
+
+	int FrameTimeHistory::GetFrameCount() const
+	{
+		return m_FrameCount;
+	}
+
+	float FrameTimeHistory::GetLatest() const
+	{
+		if (m_FrameCount == 0)
+			return 0.0f;
+
+		return m_Frames[(m_Next + (int)m_Frames.size() - 1) % (int)m_Frames.size()];
+	}
+
+	float FrameTimeHistory::GetAverage() const
+	{
+		if (m_FrameCount == 0)
+			return 0.0f;
+
+		double sum = 0.0;
+		for (int i = 0; i < m_FrameCount; ++i)
+		{
+			sum += m_Frames[i];
+		}
+
+		return (float)(sum / m_FrameCount);
+	}
+
+	float FrameTimeHistory::GetMaximum() const
+	{
+		float maximum = 0.0f;
+		for (int i = 0; i < m_FrameCount; ++i)
+		{
+			maximum = std::max(maximum, m_Frames[i]);
+		}
+
+		return maximum;
+	}
+
+	float FrameTimeHistory::GetPercentile(float p_Percentile) const
+	{
+		if (m_FrameCount == 0)
+			return 0.0f;
+
+		// Nearest rank over a scratch copy, so the history keeps its order. Multiplying before dividing keeps whole ranks exact.
+		float clamped = std::min(std::max(p_Percentile, 0.0f), 100.0f);
+		int rank = std::max(0, (int)std::ceil(clamped * m_FrameCount / 100.0) - 1);
+
+		m_Sorted.assign(m_Frames.begin(), m_Frames.begin() + m_FrameCount);
+		std::nth_element(m_Sorted.begin(), m_Sorted.begin() + rank, m_Sorted.end());
+
+		return m_Sorted[rank];
+	}
+
+	void FrameTimeHistory::SetWindowSize(int p_WindowSize)
+	{
+		m_Frames.assign(std::max(1, p_WindowSize), 0.0f);
+		m_Sorted.reserve(m_Frames.size());
+
+		Clear();
+	}
+
+	void FrameTimeHistory::Push(float p_Milliseconds)
+	{
+		m_Frames[m_Next] = p_Milliseconds;
+		m_Next = (m_Next + 1) % (int)m_Frames.size();
+		m_FrameCount = std::min(m_FrameCount + 1, (int)m_Frames.size());
+	}
+
+	void FrameTimeHistory::Clear()
+	{
+		m_Next = 0;
+		m_FrameCount = 0;
+	}
+
+	FrameLimiter::FrameLimiter()
+	{
+		m_TargetRate = 0;
+		m_Period = 0;
+		m_Deadline = 0;
+
+		SetSpinNanoseconds(DefaultSpinNanoseconds);
+	}
+
+	FrameLimiter::~FrameLimiter()
+	{
+	}
+
+	int FrameLimiter::GetTargetRate() const
+	{
+		return m_TargetRate;
+	}
+
+	bool FrameLimiter::IsEnabled() const
+	{
+		return m_TargetRate > 0;
+	}
+
+	Uint64 FrameLimiter::GetSpinNanoseconds() const
+	{
+		return m_SpinNanoseconds;
+	}
+
+	void FrameLimiter::SetTargetRate(int p_FramesPerSecond)
+	{
+		m_TargetRate = std::max(0, p_FramesPerSecond);
+		m_Period = m_TargetRate > 0 ? SDL_GetPerformanceFrequency() / m_TargetRate : 0;
+		m_Deadline = 0;
+	}
+
+	void FrameLimiter::SetSpinNanoseconds(Uint64 p_Nanoseconds)
+	{
+		m_SpinNanoseconds = p_Nanoseconds;
+		m_SpinCount = p_Nanoseconds * SDL_GetPerformanceFrequency() / 1000000000;
+	}
+
+	void FrameLimiter::Wait()
+	{
+		if (m_TargetRate <= 0)
+			return;
+
+		Uint64 now = SDL_GetPerformanceCounter();
+
+		// Start pacing from the first call, and restart after falling more than a frame behind
+		// instead of rushing frames to catch up.
+		if (m_Deadline == 0 || now > m_Deadline + m_Period)
+		{
+			m_Deadline = now + m_Period;
+			return;
+		}
+
+		if (now < m_Deadline)
+		{
+			Uint64 remaining = m_Deadline - now;
+			if (remaining > m_SpinCount)
+			{
+				Uint64 sleepCount = remaining - m_SpinCount;
+				SDL_Delay((Uint32)(sleepCount * 1000 / SDL_GetPerformanceFrequency()));
+			}
+
+			while (SDL_GetPerformanceCounter() < m_Deadline)
+			{
+			}
+		}
+
+		m_Deadline += m_Period;
+	}
+}
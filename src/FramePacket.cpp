@@ -0,0 +1,90 @@
+// FramePacket.cpp
+
+// SAGE Includes
+#include <SAGE/FramePacket.hpp>
+
+namespace SAGE
+{
+	FramePacket::FramePacket()
+	{
+		m_SpritePassCount = 0;
+		m_GeometryPassCount = 0;
+		m_UploadFence = nullptr;
+	}
+
+	FramePacket::~FramePacket()
+	{
+	}
+
+	int FramePacket::GetSpritePassCount() const
+	{
+		return m_SpritePassCount;
+	}
+
+	int FramePacket::GetGeometryPassCount() const
+	{
+		return m_GeometryPassCount;
+	}
+
+	const SpritePass& FramePacket::GetSpritePass(int p_Index) const
+	{
+		return *m_SpritePasses[p_Index];
+	}
+
+	const GeometryPass& FramePacket::GetGeometryPass(int p_Index) const
+	{
+		return *m_GeometryPasses[p_Index];
+	}
+
+	GLsync FramePacket::GetUploadFence() const
+	{
+		return m_UploadFence;
+	}
+
+	void FramePacket::SetUploadFence(GLsync p_Fence)
+	{
+		m_UploadFence = p_Fence;
+	}
+
+	SpritePass& FramePacket::AddSpritePass(Effect& p_Effect, const Camera2D& p_Camera, SortMode p_SortMode, BlendMode p_BlendMode, RasterizerState p_RasterizerState)
+	{
+		// Passes are held by pointer so the ones already handed out never move.
+		if (m_SpritePassCount == (int)m_SpritePasses.size())
+		{
+			m_SpritePasses.emplace_back(new SpritePass());
+		}
+
+		SpritePass& pass = *m_SpritePasses[m_SpritePassCount++];
+		pass.PassEffect = &p_Effect;
+		pass.Camera = p_Camera;
+		pass.Sorting = p_SortMode;
+		pass.Blending = p_BlendMode;
+		pass.Rasterizer = p_RasterizerState;
+		pass.Recorder.Clear();
+		pass.Submitted.Clear();
+
+		return pass;
+	}
+
+	GeometryPass& FramePacket::AddGeometryPass(Effect& p_Effect, const Camera2D& p_Camera)
+	{
+		if (m_GeometryPassCount == (int)m_GeometryPasses.size())
+		{
+			m_GeometryPasses.emplace_back(new GeometryPass());
+		}
+
+		GeometryPass& pass = *m_GeometryPasses[m_GeometryPassCount++];
+		pass.PassEffect = &p_Effect;
+		pass.Camera = p_Camera;
+		pass.Vertices.clear();
+
+		return pass;
+	}
+
+	void FramePacket::Clear()
+	{
+		m_SpritePassCount = 0;
+		m_GeometryPassCount = 0;
+		m_UploadFence = nullptr;
+	}
+}
@@ -0,0 +1,318 @@
+// GLRenderDevice.cpp
+
+// SAGE Includes
+#include <SAGE/GLRenderDevice.hpp>
+// SDL Includes
+#include <SDL2/SDL.h>
+
+namespace SAGE
+{
+	GLRenderDevice::GLRenderDevice()
+	{
+	}
+
+	GLRenderDevice::~GLRenderDevice()
+	{
+	}
+
+	bool GLRenderDevice::Initialize()
+	{
+#if !defined __ANDROID__
+		// Load the entry points for the current context.
+		glewExperimental = GL_TRUE;
+		GLenum result = glewInit();
+		if (result != GLEW_OK)
+		{
+			SDL_Log("[GLRenderDevice::Initialize] GLEW failed to initialize: %s", glewGetErrorString(result));
+			return false;
+		}
+#endif
+
+		return true;
+	}
+
+	bool GLRenderDevice::SupportsBufferStorage() const
+	{
+#if defined __ANDROID__
+		return false;
+#else
+		// Persistent mapping requires buffer storage (GL 4.4 or ARB_buffer_storage).
+		return GLEW_ARB_buffer_storage != GL_FALSE;
+#endif
+	}
+
+	void GLRenderDevice::GenBuffers(GLsizei p_Count, GLuint* p_Buffers)
+	{
+		glGenBuffers(p_Count, p_Buffers);
+	}
+
+	void GLRenderDevice::DeleteBuffers(GLsizei p_Count, const GLuint* p_Buffers)
+	{
+		glDeleteBuffers(p_Count, p_Buffers);
+	}
+
+	void GLRenderDevice::BindBuffer(GLenum p_Target, GLuint p_Buffer)
+	{
+		glBindBuffer(p_Target, p_Buffer);
+	}
+
+	void GLRenderDevice::BufferData(GLenum p_Target, GLsizeiptr p_Size, const void* p_Data, GLenum p_Usage)
+	{
+		glBufferData(p_Target, p_Size, p_Data, p_Usage);
+	}
+
+	void GLRenderDevice::BufferSubData(GLenum p_Target, GLintptr p_Offset, GLsizeiptr p_Size, const void* p_Data)
+	{
+		glBufferSubData(p_Target, p_Offset, p_Size, p_Data);
+	}
+
+	void GLRenderDevice::BufferStorage(GLenum p_Target, GLsizeiptr p_Size, const void* p_Data, GLbitfield p_Flags)
+	{
+		glBufferStorage(p_Target, p_Size, p_Data, p_Flags);
+	}
+
+	void* GLRenderDevice::MapBufferRange(GLenum p_Target, GLintptr p_Offset, GLsizeiptr p_Length, GLbitfield p_Access)
+	{
+		return glMapBufferRange(p_Target, p_Offset, p_Length, p_Access);
+	}
+
+	GLboolean GLRenderDevice::UnmapBuffer(GLenum p_Target)
+	{
+		return glUnmapBuffer(p_Target);
+	}
+
+	void GLRenderDevice::GenVertexArrays(GLsizei p_Count, GLuint* p_Arrays)
+	{
+		glGenVertexArrays(p_Count, p_Arrays);
+	}
+
+	void GLRenderDevice::DeleteVertexArrays(GLsizei p_Count, const GLuint* p_Arrays)
+	{
+		glDeleteVertexArrays(p_Count, p_Arrays);
+	}
+
+	void GLRenderDevice::BindVertexArray(GLuint p_Array)
+	{
+		glBindVertexArray(p_Array);
+	}
+
+	void GLRenderDevice::EnableVertexAttribArray(GLuint p_Index)
+	{
+		glEnableVertexAttribArray(p_Index);
+	}
+
+	void GLRenderDevice::VertexAttribPointer(GLuint p_Index, GLint p_Size, GLenum p_Type, GLboolean p_Normalized, GLsizei p_Stride, const void* p_Offset)
+	{
+		glVertexAttribPointer(p_Index, p_Size, p_Type, p_Normalized, p_Stride, p_Offset);
+	}
+
+	void GLRenderDevice::VertexAttribIPointer(GLuint p_Index, GLint p_Size, GLenum p_Type, GLsizei p_Stride, const void* p_Offset)
+	{
+		glVertexAttribIPointer(p_Index, p_Size, p_Type, p_Stride, p_Offset);
+	}
+
+	void GLRenderDevice::VertexAttribDivisor(GLuint p_Index, GLuint p_Divisor)
+	{
+		glVertexAttribDivisor(p_Index, p_Divisor);
+	}
+
+	void GLRenderDevice::GenTextures(GLsizei p_Count, GLuint* p_Textures)
+	{
+		glGenTextures(p_Count, p_Textures);
+	}
+
+	void GLRenderDevice::DeleteTextures(GLsizei p_Count, const GLuint* p_Textures)
+	{
+		glDeleteTextures(p_Count, p_Textures);
+	}
+
+	void GLRenderDevice::ActiveTexture(GLenum p_Unit)
+	{
+		glActiveTexture(p_Unit);
+	}
+
+	void GLRenderDevice::BindTexture(GLenum p_Target, GLuint p_Texture)
+	{
+		glBindTexture(p_Target, p_Texture);
+	}
+
+	void GLRenderDevice::TexImage2D(GLenum p_Target, GLint p_Level, GLint p_InternalFormat, GLsizei p_Width, GLsizei p_Height, GLint p_Border, GLenum p_Format, GLenum p_Type, const void* p_Pixels)
+	{
+		glTexImage2D(p_Target, p_Level, p_InternalFormat, p_Width, p_Height, p_Border, p_Format, p_Type, p_Pixels);
+	}
+
+	void GLRenderDevice::TexSubImage2D(GLenum p_Target, GLint p_Level, GLint p_X, GLint p_Y, GLsizei p_Width, GLsizei p_Height, GLenum p_Format, GLenum p_Type, const void* p_Pixels)
+	{
+		glTexSubImage2D(p_Target, p_Level, p_X, p_Y, p_Width, p_Height, p_Format, p_Type, p_Pixels);
+	}
+
+	void GLRenderDevice::TexParameteri(GLenum p_Target, GLenum p_Name, GLint p_Value)
+	{
+		glTexParameteri(p_Target, p_Name, p_Value);
+	}
+
+	void GLRenderDevice::TexParameterfv(GLenum p_Target, GLenum p_Name, const GLfloat* p_Values)
+	{
+		glTexParameterfv(p_Target, p_Name, p_Values);
+	}
+
+	GLuint GLRenderDevice::CreateShader(GLenum p_Type)
+	{
+		return glCreateShader(p_Type);
+	}
+
+	void GLRenderDevice::ShaderSource(GLuint p_Shader, GLsizei p_Count, const GLchar* const* p_Sources, const GLint* p_Lengths)
+	{
+		glShaderSource(p_Shader, p_Count, p_Sources, p_Lengths);
+	}
+
+	void GLRenderDevice::CompileShader(GLuint p_Shader)
+	{
+		glCompileShader(p_Shader);
+	}
+
+	void GLRenderDevice::GetShaderiv(GLuint p_Shader, GLenum p_Name, GLint* p_Value)
+	{
+		glGetShaderiv(p_Shader, p_Name, p_Value);
+	}
+
+	void GLRenderDevice::GetShaderInfoLog(GLuint p_Shader, GLsizei p_MaxLength, GLsizei* p_Length, GLchar* p_Log)
+	{
+		glGetShaderInfoLog(p_Shader, p_MaxLength, p_Length, p_Log);
+	}
+
+	void GLRenderDevice::DeleteShader(GLuint p_Shader)
+	{
+		glDeleteShader(p_Shader);
+	}
+
+	GLuint GLRenderDevice::CreateProgram()
+	{
+		return glCreateProgram();
+	}
+
+	void GLRenderDevice::AttachShader(GLuint p_Program, GLuint p_Shader)
+	{
+		glAttachShader(p_Program, p_Shader);
+	}
+
+	void GLRenderDevice::LinkProgram(GLuint p_Program)
+	{
+		glLinkProgram(p_Program);
+	}
+
+	void GLRenderDevice::GetProgramiv(GLuint p_Program, GLenum p_Name, GLint* p_Value)
+	{
+		glGetProgramiv(p_Program, p_Name, p_Value);
+	}
+
+	void GLRenderDevice::GetProgramInfoLog(GLuint p_Program, GLsizei p_MaxLength, GLsizei* p_Length, GLchar* p_Log)
+	{
+		glGetProgramInfoLog(p_Program, p_MaxLength, p_Length, p_Log);
+	}
+
+	void GLRenderDevice::GetActiveUniform(GLuint p_Program, GLuint p_Index, GLsizei p_MaxLength, GLsizei* p_Length, GLint* p_Size, GLenum* p_Type, GLchar* p_Name)
+	{
+		glGetActiveUniform(p_Program, p_Index, p_MaxLength, p_Length, p_Size, p_Type, p_Name);
+	}
+
+	void GLRenderDevice::DeleteProgram(GLuint p_Program)
+	{
+		glDeleteProgram(p_Program);
+	}
+
+	void GLRenderDevice::UseProgram(GLuint p_Program)
+	{
+		glUseProgram(p_Program);
+	}
+
+	GLint GLRenderDevice::GetUniformLocation(GLuint p_Program, const GLchar* p_Name)
+	{
+		return glGetUniformLocation(p_Program, p_Name);
+	}
+
+	void GLRenderDevice::Uniform1i(GLint p_Location, GLint p_Value)
+	{
+		glUniform1i(p_Location, p_Value);
+	}
+
+	void GLRenderDevice::Uniform1f(GLint p_Location, GLfloat p_Value)
+	{
+		glUniform1f(p_Location, p_Value);
+	}
+
+	void GLRenderDevice::UniformMatrix4fv(GLint p_Location, GLsizei p_Count, GLboolean p_Transpose, const GLfloat* p_Values)
+	{
+		glUniformMatrix4fv(p_Location, p_Count, p_Transpose, p_Values);
+	}
+
+	void GLRenderDevice::Enable(GLenum p_Capability)
+	{
+		glEnable(p_Capability);
+	}
+
+	void GLRenderDevice::Disable(GLenum p_Capability)
+	{
+		glDisable(p_Capability);
+	}
+
+	void GLRenderDevice::BlendFunc(GLenum p_Source, GLenum p_Destination)
+	{
+		glBlendFunc(p_Source, p_Destination);
+	}
+
+	void GLRenderDevice::CullFace(GLenum p_Face)
+	{
+		glCullFace(p_Face);
+	}
+
+	void GLRenderDevice::Viewport(GLint p_X, GLint p_Y, GLsizei p_Width, GLsizei p_Height)
+	{
+		glViewport(p_X, p_Y, p_Width, p_Height);
+	}
+
+	void GLRenderDevice::ClearColor(GLfloat p_Red, GLfloat p_Green, GLfloat p_Blue, GLfloat p_Alpha)
+	{
+		glClearColor(p_Red, p_Green, p_Blue, p_Alpha);
+	}
+
+	void GLRenderDevice::Clear(GLbitfield p_Mask)
+	{
+		glClear(p_Mask);
+	}
+
+	void GLRenderDevice::DrawElements(GLenum p_Mode, GLsizei p_Count, GLenum p_Type, const void* p_Indices)
+	{
+		glDrawElements(p_Mode, p_Count, p_Type, p_Indices);
+	}
+
+	void GLRenderDevice::DrawElementsBaseVertex(GLenum p_Mode, GLsizei p_Count, GLenum p_Type, const void* p_Indices, GLint p_BaseVertex)
+	{
+		glDrawElementsBaseVertex(p_Mode, p_Count, p_Type, p_Indices, p_BaseVertex);
+	}
+
+	void GLRenderDevice::DrawArraysInstanced(GLenum p_Mode, GLint p_First, GLsizei p_Count, GLsizei p_InstanceCount)
+	{
+		glDrawArraysInstanced(p_Mode, p_First, p_Count, p_InstanceCount);
+	}
+
+	GLsync GLRenderDevice::FenceSync(GLenum p_Condition, GLbitfield p_Flags)
+	{
+		return glFenceSync(p_Condition, p_Flags);
+	}
+
+	GLenum GLRenderDevice::ClientWaitSync(GLsync p_Sync, GLbitfield p_Flags, GLuint64 p_Timeout)
+	{
+		return glClientWaitSync(p_Sync, p_Flags, p_Timeout);
+	}
+
+	void GLRenderDevice::DeleteSync(GLsync p_Sync)
+	{
+		glDeleteSync(p_Sync);
+	}
+
+	void GLRenderDevice::Flush()
+	{
+		glFlush();
+	}
+}
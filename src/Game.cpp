@@ -3,6 +3,9 @@
 // SAGE Includes
 #include <SAGE/Game.hpp>
 #include <SAGE/Events.hpp>
+#include <SAGE/Profiler.hpp>
+// STL Includes
+#include <cmath>
 
 namespace SAGE
 {
@@ -10,10 +13,20 @@ namespace SAGE
 	{
 		m_Window = new Window(this);
 		m_ScreenManager = new ScreenManager(this);
+		m_Running = false;
+		m_ThreadedRendering = false;
+		m_FixedTimestep = false;
+		m_FixedStep = 0.0f;
+		m_MaxStepsPerFrame = DefaultMaxStepsPerFrame;
+		m_Accumulator = 0.0;
+		m_InterpolationAlpha = 1.0f;
 	}
 
 	Game::~Game()
 	{
+		// The render thread draws into the window, so it has to go first.
+		m_RenderThread.Stop();
+
 		if (m_Window != nullptr)
 		{
 			delete m_Window;
@@ -35,6 +48,99 @@ namespace SAGE
 		return m_ScreenManager;
 	}
 
+	JobSystem* Game::GetJobSystem()
+	{
+		return &m_JobSystem;
+	}
+
+	TextureStreamer* Game::GetTextureStreamer()
+	{
+		return &m_TextureStreamer;
+	}
+
+	const RenderStatsHistory& Game::GetRenderStats() const
+	{
+		return m_RenderStats;
+	}
+
+	bool Game::IsFixedTimestep() const
+	{
+		return m_FixedTimestep;
+	}
+
+	float Game::GetFixedTimestep() const
+	{
+		return m_FixedStep;
+	}
+
+	int Game::GetMaxStepsPerFrame() const
+	{
+		return m_MaxStepsPerFrame;
+	}
+
+	float Game::GetInterpolationAlpha() const
+	{
+		return m_InterpolationAlpha;
+	}
+
+	int Game::GetFrameRateLimit() const
+	{
+		return m_FrameLimiter.GetTargetRate();
+	}
+
+	const FrameTimeHistory& Game::GetFrameTimes() const
+	{
+		return m_FrameTimes;
+	}
+
+	bool Game::IsThreadedRendering() const
+	{
+		return m_ThreadedRendering;
+	}
+
+	void Game::SetRenderStatsWindow(int p_FrameCount)
+	{
+		m_RenderStats.SetWindowSize(p_FrameCount);
+	}
+
+	void Game::SetFixedTimestep(float p_Step, int p_MaxStepsPerFrame)
+	{
+		if (p_Step <= 0.0f)
+		{
+			SDL_Log("[Game::SetFixedTimestep] The step must be greater than zero.");
+			return;
+		}
+
+		m_FixedTimestep = true;
+		m_FixedStep = p_Step;
+		m_MaxStepsPerFrame = p_MaxStepsPerFrame < 1 ? 1 : p_MaxStepsPerFrame;
+		m_Accumulator = 0.0;
+		m_InterpolationAlpha = 0.0f;
+	}
+
+	void Game::DisableFixedTimestep()
+	{
+		m_FixedTimestep = false;
+		m_Accumulator = 0.0;
+		m_InterpolationAlpha = 1.0f;
+	}
+
+	void Game::SetFrameRateLimit(int p_FramesPerSecond)
+	{
+		m_FrameLimiter.SetTargetRate(p_FramesPerSecond);
+	}
+
+	void Game::SetThreadedRendering(bool p_Enabled)
+	{
+		if (m_RenderThread.IsRunning())
+		{
+			SDL_Log("[Game::SetThreadedRendering] Cannot change threaded rendering while the game is running.");
+			return;
+		}
+
+		m_ThreadedRendering = p_Enabled;
+	}
+
 	int Game::Start()
 	{
 		m_Running = true;
@@ -42,24 +148,91 @@ namespace SAGE
 		if (Initialize() < 0)
 			return -1;
 
+		if (m_ThreadedRendering && !m_RenderThread.Start(m_Window))
+			return -1;
+
+		SAGE_PROFILE_THREAD("Main");
+
 		while (m_Running)
 		{
-			Events::Poll();
+			SAGE_PROFILE_FRAME();
+			SAGE_PROFILE_ZONE("Game::Frame");
 
-			if (Update(m_Timer.GetDeltaTime()) < 0)
-				return -1;
+			{
+				SAGE_PROFILE_ZONE("Events::Poll");
+				Events::Poll();
+			}
 
-			m_Window->Clear();
+			// Textures finished this frame are ready before Update sees them.
+			m_TextureStreamer.Update();
 
-			if (Render(m_SpriteBatch) < 0)
-				return -1;
+			// The delta covers the whole previous frame, including any limiter wait.
+			float deltaTime = m_Timer.GetDeltaTime();
+			m_FrameTimes.Push(deltaTime * 1000.0f);
 
-			if (Render(m_GeometryBatch) < 0)
-				return -1;
+			{
+				SAGE_PROFILE_ZONE("Game::Update");
+				if (Simulate(deltaTime) < 0)
+					return -1;
+			}
+
+			// Threaded frames are recorded here and cleared and drawn by the render thread.
+			bool threaded = m_RenderThread.IsRunning();
+			if (threaded)
+			{
+				FramePacket& packet = m_RenderThread.AcquirePacket();
+				m_SpriteBatch.SetCapture(&packet);
+				m_GeometryBatch.SetCapture(&packet);
+			}
+			else
+			{
+				m_Window->Clear();
+			}
+
+			m_SpriteBatch.ResetStats();
+			m_GeometryBatch.ResetStats();
+
+			{
+				SAGE_PROFILE_ZONE("Game::Render(SpriteBatch)");
+				if (Render(m_SpriteBatch, m_InterpolationAlpha) < 0)
+					return -1;
+			}
+
+			{
+				SAGE_PROFILE_ZONE("Game::Render(GeometryBatch)");
+				if (Render(m_GeometryBatch, m_InterpolationAlpha) < 0)
+					return -1;
+			}
 
-			m_Window->Flip();
+			m_SpriteBatch.EndFrame();
+
+			if (threaded)
+			{
+				m_SpriteBatch.SetCapture(nullptr);
+				m_GeometryBatch.SetCapture(nullptr);
+				m_RenderThread.SubmitPacket();
+
+				m_RenderStats.Push(m_RenderThread.GetCompletedStats());
+			}
+			else
+			{
+				RenderStats frameStats = m_SpriteBatch.GetStats();
+				frameStats += m_GeometryBatch.GetStats();
+				m_RenderStats.Push(frameStats);
+
+				SAGE_PROFILE_ZONE("Window::Flip");
+				m_Window->Flip();
+			}
+
+			{
+				SAGE_PROFILE_ZONE("FrameLimiter::Wait");
+				m_FrameLimiter.Wait();
+			}
 		}
 
+		if (!m_RenderThread.Stop())
+			return -1;
+
 		if (Finalize() < 0)
 			return - 1;
 
@@ -75,6 +248,9 @@ namespace SAGE
 	{
 		m_Timer.Start();
 
+		if (!m_JobSystem.Initialize())
+			return -1;
+
 		if (!m_Window->Initialize())
 			return -1;
 
@@ -84,11 +260,17 @@ namespace SAGE
 		if (!m_GeometryBatch.Initialize())
 			return -1;
 
+		if (!m_TextureStreamer.Initialize(&m_JobSystem))
+			return -1;
+
 		return 0;
 	}
 
 	int Game::Finalize()
 	{
+		if (!m_TextureStreamer.Finalize())
+			return -1;
+
 		if (!m_SpriteBatch.Finalize())
 			return -1;
 
@@ -98,6 +280,9 @@ namespace SAGE
 		if (!m_Window->Finalize())
 			return -1;
 
+		if (!m_JobSystem.Finalize())
+			return -1;
+
 		return 0;
 	}
 
@@ -110,4 +295,47 @@ namespace SAGE
 	{
 		return 0;
 	}
+
+	int Game::Render(SpriteBatch& p_SpriteBatch, float p_Alpha)
+	{
+		return Render(p_SpriteBatch);
+	}
+
+	int Game::Render(GeometryBatch& p_GeometryBatch, float p_Alpha)
+	{
+		return Render(p_GeometryBatch);
+	}
+
+	int Game::Simulate(float p_DeltaTime)
+	{
+		if (!m_FixedTimestep)
+		{
+			m_InterpolationAlpha = 1.0f;
+
+			return Update(p_DeltaTime);
+		}
+
+		m_Accumulator += p_DeltaTime;
+
+		int steps = 0;
+		while (m_Accumulator >= m_FixedStep)
+		{
+			// Falling further behind than the step limit would only make the next frame slower, so drop the backlog.
+			if (steps == m_MaxStepsPerFrame)
+			{
+				m_Accumulator = fmod(m_Accumulator, (double)m_FixedStep);
+				break;
+			}
+
+			if (Update(m_FixedStep) < 0)
+				return -1;
+
+			m_Accumulator -= m_FixedStep;
+			steps++;
+		}
+
+		m_InterpolationAlpha = (float)(m_Accumulator / m_FixedStep);
+
+		return 0;
+	}
 }
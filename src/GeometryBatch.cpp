@@ -3,7 +3,10 @@
 // OpenGL Includes
 #include <GL/glew.h>
 // SAGE Includes
+#include <SAGE/FramePacket.hpp>
 #include <SAGE/GeometryBatch.hpp>
+#include <SAGE/IRenderDevice.hpp>
+#include <SAGE/RenderState.hpp>
 // SDL Includes
 #include <SDL2/SDL.h>
 
@@ -14,6 +17,8 @@ namespace SAGE
 		m_WithinDrawPair = false;
 		m_ItemCount = 0;
 		m_FlushCount = 0;
+		m_Capture = nullptr;
+		m_CapturePass = nullptr;
 	}
 
 	GeometryBatch::~GeometryBatch()
@@ -26,18 +31,44 @@ namespace SAGE
 		return m_FlushCount;
 	}
 
+	const RenderStats& GeometryBatch::GetStats() const
+	{
+		return m_Stats;
+	}
+
+	void GeometryBatch::ResetStats()
+	{
+		m_Stats.Clear();
+	}
+
+	bool GeometryBatch::IsCapturing() const
+	{
+		return m_Capture != nullptr;
+	}
+
+	bool GeometryBatch::SetCapture(FramePacket* p_Packet)
+	{
+		if (m_WithinDrawPair)
+		{
+			SDL_Log("[GeometryBatch::SetCapture] Cannot change capture within a draw pair.");
+			return false;
+		}
+
+		m_Capture = p_Packet;
+
+		return true;
+	}
+
 	bool GeometryBatch::Initialize()
 	{
 		GLsizei sizeUShort = sizeof(GLushort);
 		GLsizei sizeFloat = sizeof(GLfloat);
 		GLsizei sizeVPC = sizeof(VertexPositionColor);
 
-		// Enable GLew.
-		glewExperimental = GL_TRUE;
-		GLenum res = glewInit();
-		if (res != GLEW_OK)
+		// Prepare the render device.
+		if (!IRenderDevice::Get().Initialize())
 		{
-			SDL_Log("[GeometryBatch::Initialize] GLEW failed to initialize: %s", glewGetErrorString(res));
+			SDL_Log("[GeometryBatch::Initialize] The render device failed to initialize.");
 			return false;
 		}
 
@@ -47,43 +78,47 @@ namespace SAGE
 			indexData[i] = i;
 		}
 
-		m_IndexBufferObject = -1;
-		glGenBuffers(1, &m_IndexBufferObject);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferObject);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, MaxIndexCount * sizeUShort, indexData, GL_STATIC_DRAW);
-
 		m_VertexArrayObject = -1;
-		glGenVertexArrays(1, &m_VertexArrayObject);
-		glBindVertexArray(m_VertexArrayObject);
+		IRenderDevice::Get().GenVertexArrays(1, &m_VertexArrayObject);
+		RenderState::BindVertexArray(m_VertexArrayObject);
+
+		// The vertex array keeps the index buffer bound.
+		m_IndexBufferObject = -1;
+		IRenderDevice::Get().GenBuffers(1, &m_IndexBufferObject);
+		RenderState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferObject);
+		IRenderDevice::Get().BufferData(GL_ELEMENT_ARRAY_BUFFER, MaxIndexCount * sizeUShort, indexData, GL_STATIC_DRAW);
 
 		m_VertexBufferObject = -1;
-		glGenBuffers(1, &m_VertexBufferObject);
-		glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
-		glBufferData(GL_ARRAY_BUFFER, MaxVertexCount * sizeVPC, nullptr, GL_DYNAMIC_DRAW);
+		IRenderDevice::Get().GenBuffers(1, &m_VertexBufferObject);
+		RenderState::BindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
+		IRenderDevice::Get().BufferData(GL_ARRAY_BUFFER, MaxVertexCount * sizeVPC, nullptr, GL_DYNAMIC_DRAW);
 
 		#define BUFFER_OFFSET(i) ((char*)0 + (i))
 
 		// Position
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeVPC, BUFFER_OFFSET(sizeFloat * 0));
+		IRenderDevice::Get().EnableVertexAttribArray(0);
+		IRenderDevice::Get().VertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeVPC, BUFFER_OFFSET(sizeFloat * 0));
 		// Color
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeVPC, BUFFER_OFFSET(sizeFloat * 2));
+		IRenderDevice::Get().EnableVertexAttribArray(1);
+		IRenderDevice::Get().VertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeVPC, BUFFER_OFFSET(sizeFloat * 2));
 
 		#undef BUFFER_OFFSET
 
-		glBindVertexArray(0);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		RenderState::BindVertexArray(0);
+		RenderState::BindBuffer(GL_ARRAY_BUFFER, 0);
 
 		return true;
 	}
 
 	bool GeometryBatch::Finalize()
 	{
-		glDeleteVertexArrays(1, &m_VertexArrayObject);
-		glDeleteBuffers(1, &m_VertexBufferObject);
-		glDeleteBuffers(1, &m_IndexBufferObject);
+		RenderState::ForgetVertexArray(m_VertexArrayObject);
+		RenderState::ForgetBuffer(m_VertexBufferObject);
+		RenderState::ForgetBuffer(m_IndexBufferObject);
+
+		IRenderDevice::Get().DeleteVertexArrays(1, &m_VertexArrayObject);
+		IRenderDevice::Get().DeleteBuffers(1, &m_VertexBufferObject);
+		IRenderDevice::Get().DeleteBuffers(1, &m_IndexBufferObject);
 
 		return true;
 	}
@@ -100,9 +135,17 @@ namespace SAGE
 		m_ItemCount = 0;
 		m_FlushCount = 0;
 
+		if (m_Capture != nullptr)
+		{
+			m_CapturePass = &m_Capture->AddGeometryPass(p_Effect, p_Camera);
+
+			return true;
+		}
+
+		// Uniforms apply to the bound program, so bind it first.
+		p_Effect.Use();
 		p_Effect.SetProjection(p_Camera.GetProjectionMatrix());
 		p_Effect.SetModelView(p_Camera.GetModelViewMatrix());
-		p_Effect.Use();
 
 		return true;
 	}
@@ -115,6 +158,34 @@ namespace SAGE
 			return false;
 		}
 
+		if (m_CapturePass != nullptr)
+		{
+			VertexPositionColor vertex;
+			vertex.Color.R = p_Color.GetRed();
+			vertex.Color.G = p_Color.GetGreen();
+			vertex.Color.B = p_Color.GetBlue();
+			vertex.Color.A = p_Color.GetAlpha();
+
+			vertex.Position.X = p_PositionA.X;
+			vertex.Position.Y = p_PositionA.Y;
+			m_CapturePass->Vertices.push_back(vertex);
+
+			vertex.Position.X = p_PositionB.X;
+			vertex.Position.Y = p_PositionB.Y;
+			m_CapturePass->Vertices.push_back(vertex);
+
+			return true;
+		}
+
+		// The item list holds one batch; draw it and start over when full.
+		if (m_ItemCount == MaxBatchSize)
+		{
+			Render();
+			m_ItemCount = 0;
+
+			m_Stats.CapacityFlushes++;
+		}
+
 		GeometryBatchItem& item = m_BatchItemList[m_ItemCount++];
 
 		item.VertexA.Position.X = p_PositionA.X;
@@ -135,6 +206,11 @@ namespace SAGE
 	}
 
 	bool GeometryBatch::DrawLines(const std::vector<Vector2>& p_Positions, const Color& p_Color)
+	{
+		return DrawLines(p_Positions.data(), static_cast<int>(p_Positions.size()), p_Color);
+	}
+
+	bool GeometryBatch::DrawLines(const Vector2* p_Positions, int p_PositionCount, const Color& p_Color)
 	{
 		if (!m_WithinDrawPair)
 		{
@@ -142,13 +218,13 @@ namespace SAGE
 			return false;
 		}
 
-		if (p_Positions.size() < 2)
+		if (p_PositionCount < 2)
 		{
 			SDL_Log("[GeometryBatch::DrawLines] Must supply two or more positions to draw.");
 			return false;
 		}
 
-		for (int i = 1; i < (int)p_Positions.size(); ++i)
+		for (int i = 1; i < p_PositionCount; ++i)
 		{
 			if (!DrawLine(p_Positions[i - 1], p_Positions[i], p_Color))
 			{
@@ -187,6 +263,14 @@ namespace SAGE
 	}
 
 	bool GeometryBatch::DrawCircle(const Vector2& p_Position, float p_Radius, const Color& p_Color, int p_Count)
+	{
+		// The table is only rebuilt when the segment count changes.
+		m_Circle.SetSegmentCount(p_Count);
+
+		return DrawCircle(p_Position, p_Radius, p_Color, m_Circle);
+	}
+
+	bool GeometryBatch::DrawCircle(const Vector2& p_Position, float p_Radius, const Color& p_Color, const UnitCircle& p_Circle)
 	{
 		if (!m_WithinDrawPair)
 		{
@@ -194,21 +278,13 @@ namespace SAGE
 			return false;
 		}
 
-		float step = (float)(2.0f * M_PI) / (float)p_Count;
-		std::vector<float> cosList(p_Count + 1);
-		std::vector<float> sinList(p_Count + 1);
+		const Vector2* points = p_Circle.GetPoints();
+		int segmentCount = p_Circle.GetSegmentCount();
 
-		// Pre-calculate multi-use trigonometry. 
-		for (int i = 0; i < p_Count + 1; ++i)
+		for (int i = 0; i < segmentCount; ++i)
 		{
-			cosList[i] = cosf(i * step) * p_Radius;
-			sinList[i] = sinf(i * step) * p_Radius;
-		}
-
-		for (int i = 0; i < p_Count; ++i)
-		{
-			Vector2 positionA(p_Position.X + cosList[i], p_Position.Y + sinList[i]);
-			Vector2 positionB(p_Position.X + cosList[i + 1], p_Position.Y + sinList[i + 1]);
+			Vector2 positionA(p_Position.X + points[i].X * p_Radius, p_Position.Y + points[i].Y * p_Radius);
+			Vector2 positionB(p_Position.X + points[i + 1].X * p_Radius, p_Position.Y + points[i + 1].Y * p_Radius);
 
 			if (!DrawLine(positionA, positionB, p_Color))
 			{
@@ -277,6 +353,39 @@ namespace SAGE
 		return true;
 	}
 
+	bool GeometryBatch::DrawLineList(const VertexPositionColor* p_Vertices, int p_VertexCount)
+	{
+		if (!m_WithinDrawPair)
+		{
+			SDL_Log("[GeometryBatch::DrawLineList] Must start a draw pair first.");
+			return false;
+		}
+
+		if (m_CapturePass != nullptr)
+		{
+			m_CapturePass->Vertices.insert(m_CapturePass->Vertices.end(), p_Vertices, p_Vertices + p_VertexCount);
+
+			return true;
+		}
+
+		for (int i = 0; i + 1 < p_VertexCount; i += 2)
+		{
+			if (m_ItemCount == MaxBatchSize)
+			{
+				Render();
+				m_ItemCount = 0;
+
+				m_Stats.CapacityFlushes++;
+			}
+
+			GeometryBatchItem& item = m_BatchItemList[m_ItemCount++];
+			item.VertexA = p_Vertices[i];
+			item.VertexB = p_Vertices[i + 1];
+		}
+
+		return true;
+	}
+
 	bool GeometryBatch::End()
 	{
 		if (!m_WithinDrawPair)
@@ -285,6 +394,8 @@ namespace SAGE
 			return false;
 		}
 
+		m_CapturePass = nullptr;
+
 		if (m_ItemCount > 0)
 			Render();
 
@@ -295,6 +406,7 @@ namespace SAGE
 
 	void GeometryBatch::Render()
 	{
+		int issuedCallCount = RenderState::GetIssuedCallCount();
 		int length = 0;
 
 		for (int i = 0; i < m_ItemCount; ++i)
@@ -305,6 +417,8 @@ namespace SAGE
 			{
 				Flush(length);
 				length = 0;
+
+				m_Stats.CapacityFlushes++;
 			}
 
 			m_VertexBuffer[length * 2 + 0] = item.VertexA;
@@ -314,6 +428,8 @@ namespace SAGE
 		}
 
 		Flush(length);
+
+		m_Stats.StateChanges += RenderState::GetIssuedCallCount() - issuedCallCount;
 	}
 
 	void GeometryBatch::Flush(int p_Length)
@@ -322,24 +438,21 @@ namespace SAGE
 		if (p_Length == 0)
 			return;
 
-		// Bind the vertex array.
-		glBindVertexArray(m_VertexArrayObject);
+		// Bind the vertex array, which also holds the index buffer.
+		RenderState::BindVertexArray(m_VertexArrayObject);
 
 		// Bind the vertex buffer.
-		glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
+		RenderState::BindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
 
 		// Insert subset into buffer.
-		glBufferSubData(GL_ARRAY_BUFFER, 0, p_Length * 2 * sizeof(VertexPositionColor), m_VertexBuffer);
-
-		// Bind the element buffer and draw.
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferObject);
-		glDrawElements(GL_LINES, p_Length * 2, GL_UNSIGNED_SHORT, nullptr);
+		IRenderDevice::Get().BufferSubData(GL_ARRAY_BUFFER, 0, p_Length * 2 * sizeof(VertexPositionColor), m_VertexBuffer);
 
-		// Clear bindings.
-		glBindVertexArray(0);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		// Draw.
+		IRenderDevice::Get().DrawElements(GL_LINES, p_Length * 2, GL_UNSIGNED_SHORT, nullptr);
 
 		m_FlushCount++;
+		m_Stats.DrawCalls++;
+		m_Stats.Vertices += p_Length * 2;
+		m_Stats.UploadedBytes += p_Length * 2 * sizeof(VertexPositionColor);
 	}
 }
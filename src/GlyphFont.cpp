@@ -3,6 +3,7 @@
 // SAGE Includes
 #include <SAGE/GlyphFont.hpp>
 #include <SAGE/Math.hpp>
+#include <SAGE/Profiler.hpp>
 // SDL Includes
 #if defined __ANDROID__
 	#include <SDL.h>
@@ -83,6 +84,8 @@ namespace SAGE
 
 	bool GlyphFont::Load(const std::string& p_Filename, const GlyphFontOptions& p_Options)
 	{
+		SAGE_PROFILE_ZONE("GlyphFont::Load");
+
 		SDL_Log("[GlyphFont::Load] Entered.");
 
 		//const int dpi = 72;
@@ -14,4 +14,9 @@ namespace SAGE
 	{
 		m_Game = nullptr;
 	}
+
+	Game* IGameComponent::GetGame() const
+	{
+		return m_Game;
+	}
 }
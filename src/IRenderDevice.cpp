@@ -0,0 +1,29 @@
+// IRenderDevice.cpp
+
+// SAGE Includes
+#include <SAGE/GLRenderDevice.hpp>
+#include <SAGE/IRenderDevice.hpp>
+#include <SAGE/RenderState.hpp>
+
+namespace SAGE
+{
+	IRenderDevice* IRenderDevice::sDevice = nullptr;
+
+	IRenderDevice& IRenderDevice::Get()
+	{
+		static GLRenderDevice sGLDevice;
+
+		if (sDevice == nullptr)
+			return sGLDevice;
+
+		return *sDevice;
+	}
+
+	void IRenderDevice::Set(IRenderDevice* p_Device)
+	{
+		sDevice = p_Device;
+
+		// Shadowed bindings belong to the previous device.
+		RenderState::Reset();
+	}
+}
@@ -0,0 +1,358 @@
+// JobSystem.cpp
+
+// SAGE Includes
+#include <SAGE/JobSystem.hpp>
+#include <SAGE/Profiler.hpp>
+// SDL Includes
+#include <SDL2/SDL.h>
+// STL Includes
+#include <algorithm>
+
+namespace
+{
+	// Queue 0 belongs to threads outside the pool; worker i owns queue i + 1.
+	thread_local int sQueueIndex = 0;
+	thread_local const SAGE::JobSystem* sQueueOwner = nullptr;
+}
+
+namespace SAGE
+{
+	JobCounter::JobCounter() : m_Count(0)
+	{
+	}
+
+	JobCounter::~JobCounter()
+	{
+	}
+
+	int JobCounter::GetCount() const
+	{
+		return m_Count.load(std::memory_order_acquire);
+	}
+
+	bool JobCounter::IsDone() const
+	{
+		return GetCount() == 0;
+	}
+
+	JobSystem::JobSystem() : m_Running(false), m_QueuedCount(0)
+	{
+	}
+
+	JobSystem::~JobSystem()
+	{
+		Finalize();
+	}
+
+	bool JobSystem::IsRunning() const
+	{
+		return m_Running.load();
+	}
+
+	int JobSystem::GetWorkerCount() const
+	{
+		return (int)m_Workers.size();
+	}
+
+	bool JobSystem::Initialize(int p_WorkerCount)
+	{
+		if (m_Running.load())
+		{
+			SDL_Log("[JobSystem::Initialize] The job system is already running.");
+			return false;
+		}
+
+		int workerCount = p_WorkerCount;
+		if (workerCount <= 0)
+			workerCount = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+
+		m_Queues.clear();
+		for (int i = 0; i < workerCount + 1; ++i)
+		{
+			m_Queues.emplace_back(new WorkerQueue());
+		}
+
+		m_QueuedCount = 0;
+		m_Running = true;
+
+		for (int i = 0; i < workerCount; ++i)
+		{
+			m_Workers.emplace_back(&JobSystem::WorkerMain, this, i + 1);
+		}
+
+		return true;
+	}
+
+	bool JobSystem::Finalize()
+	{
+		if (!m_Running.load())
+			return true;
+
+		// Workers drain their queues before exiting, so nothing scheduled is lost.
+		{
+			std::lock_guard<std::mutex> lock(m_WakeMutex);
+			m_Running = false;
+		}
+		m_WakeCondition.notify_all();
+
+		for (std::thread& worker : m_Workers)
+		{
+			worker.join();
+		}
+
+		m_Workers.clear();
+
+		while (RunNext(true))
+		{
+		}
+
+		if (!m_Pending.empty())
+		{
+			SDL_Log("[JobSystem::Finalize] Dropping %d jobs whose dependencies never completed.", (int)m_Pending.size());
+			m_Pending.clear();
+		}
+
+		m_Queues.clear();
+
+		return true;
+	}
+
+	void JobSystem::Schedule(const Job& p_Job, JobCounter* p_Counter, const JobCounter* p_Dependency)
+	{
+		if (p_Counter != nullptr)
+			p_Counter->m_Count.fetch_add(1, std::memory_order_acq_rel);
+
+		QueuedJob job;
+		job.Work = p_Job;
+		job.Counter = p_Counter;
+		job.Dependency = p_Dependency;
+		job.Background = false;
+
+		// Checked under the pending lock, so a dependency finishing meanwhile still releases the job.
+		if (p_Dependency != nullptr)
+		{
+			std::lock_guard<std::mutex> lock(m_PendingMutex);
+			if (!p_Dependency->IsDone())
+			{
+				m_Pending.push_back(std::move(job));
+				return;
+			}
+		}
+
+		Enqueue(std::move(job));
+	}
+
+	void JobSystem::ScheduleBackground(const Job& p_Job, JobCounter* p_Counter)
+	{
+		if (p_Counter != nullptr)
+			p_Counter->m_Count.fetch_add(1, std::memory_order_acq_rel);
+
+		QueuedJob job;
+		job.Work = p_Job;
+		job.Counter = p_Counter;
+		job.Dependency = nullptr;
+		job.Background = true;
+
+		Enqueue(std::move(job));
+	}
+
+	void JobSystem::Wait(const JobCounter& p_Counter)
+	{
+		while (!p_Counter.IsDone())
+		{
+			if (!RunNext(false))
+				std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::ParallelFor(int p_Begin, int p_End, const JobRange& p_Body, int p_Grain)
+	{
+		SAGE_PROFILE_ZONE("JobSystem::ParallelFor");
+
+		int count = p_End - p_Begin;
+		if (count <= 0)
+			return;
+
+		int grain = p_Grain;
+		if (grain <= 0)
+		{
+			int threadCount = GetWorkerCount() + 1;
+			grain = std::max(1, count / (threadCount * 4));
+		}
+
+		// Small ranges, or a stopped pool, run inline.
+		if (grain >= count || !m_Running.load())
+		{
+			p_Body(p_Begin, p_End);
+			return;
+		}
+
+		JobCounter counter;
+		for (int first = p_Begin; first < p_End; first += grain)
+		{
+			int last = std::min(first + grain, p_End);
+			Schedule([&p_Body, first, last]() { p_Body(first, last); }, &counter);
+		}
+
+		Wait(counter);
+	}
+
+	void JobSystem::Enqueue(QueuedJob&& p_Job)
+	{
+		if (m_Queues.empty())
+		{
+			// Not initialized: run the job right here so callers never hang.
+			p_Job.Work();
+			Complete(p_Job.Counter);
+			return;
+		}
+
+		int index = sQueueOwner == this ? sQueueIndex : 0;
+		WorkerQueue& queue = p_Job.Background ? m_BackgroundQueue : *m_Queues[index];
+
+		{
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			queue.Jobs.push_back(std::move(p_Job));
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_WakeMutex);
+			m_QueuedCount.fetch_add(1, std::memory_order_release);
+		}
+		m_WakeCondition.notify_one();
+	}
+
+	bool JobSystem::RunNext(bool p_Background)
+	{
+		QueuedJob job;
+		if (!PopJob(job, p_Background))
+			return false;
+
+		job.Work();
+		Complete(job.Counter);
+
+		return true;
+	}
+
+	bool JobSystem::PopJob(QueuedJob& p_Job, bool p_Background)
+	{
+		if (m_QueuedCount.load(std::memory_order_acquire) == 0 || m_Queues.empty())
+			return false;
+
+		int ownIndex = sQueueOwner == this ? sQueueIndex : 0;
+		int queueCount = (int)m_Queues.size();
+
+		// Newest first from our own queue, which is still warm in cache.
+		{
+			WorkerQueue& queue = *m_Queues[ownIndex];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			if (!queue.Jobs.empty())
+			{
+				p_Job = std::move(queue.Jobs.back());
+				queue.Jobs.pop_back();
+				m_QueuedCount.fetch_sub(1, std::memory_order_acq_rel);
+				return true;
+			}
+		}
+
+		// Oldest first from everyone else, which tends to take the largest remaining work.
+		for (int i = 1; i < queueCount; ++i)
+		{
+			WorkerQueue& queue = *m_Queues[(ownIndex + i) % queueCount];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			if (!queue.Jobs.empty())
+			{
+				p_Job = std::move(queue.Jobs.front());
+				queue.Jobs.pop_front();
+				m_QueuedCount.fetch_sub(1, std::memory_order_acq_rel);
+				return true;
+			}
+		}
+
+		// Background jobs last, oldest first.
+		if (p_Background)
+		{
+			std::lock_guard<std::mutex> lock(m_BackgroundQueue.Mutex);
+			if (!m_BackgroundQueue.Jobs.empty())
+			{
+				p_Job = std::move(m_BackgroundQueue.Jobs.front());
+				m_BackgroundQueue.Jobs.pop_front();
+				m_QueuedCount.fetch_sub(1, std::memory_order_acq_rel);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void JobSystem::Complete(JobCounter* p_Counter)
+	{
+		if (p_Counter == nullptr)
+			return;
+
+		// Anything but the last decrement needs no lock.
+		int count = p_Counter->m_Count.load(std::memory_order_acquire);
+		while (count > 1)
+		{
+			if (p_Counter->m_Count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel))
+				return;
+		}
+
+		// The last one happens under the pending lock and dependents are matched by address only, since
+		// a thread waiting on the counter may destroy it as soon as it sees zero.
+		std::vector<QueuedJob> ready;
+
+		{
+			std::lock_guard<std::mutex> lock(m_PendingMutex);
+			if (p_Counter->m_Count.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				return;
+
+			ReleasePending(p_Counter, ready);
+		}
+
+		for (QueuedJob& job : ready)
+		{
+			Enqueue(std::move(job));
+		}
+	}
+
+	void JobSystem::ReleasePending(const JobCounter* p_Dependency, std::vector<QueuedJob>& p_Ready)
+	{
+		for (size_t i = 0; i < m_Pending.size();)
+		{
+			if (m_Pending[i].Dependency == p_Dependency)
+			{
+				p_Ready.push_back(std::move(m_Pending[i]));
+				m_Pending[i] = std::move(m_Pending.back());
+				m_Pending.pop_back();
+			}
+			else
+			{
+				++i;
+			}
+		}
+	}
+
+	void JobSystem::WorkerMain(int p_Index)
+	{
+		SAGE_PROFILE_THREAD("Job Worker");
+
+		sQueueIndex = p_Index;
+		sQueueOwner = this;
+
+		while (true)
+		{
+			if (RunNext(true))
+				continue;
+
+			std::unique_lock<std::mutex> lock(m_WakeMutex);
+			m_WakeCondition.wait(lock, [this]()
+			{
+				return m_QueuedCount.load(std::memory_order_acquire) > 0 || !m_Running.load();
+			});
+
+			if (!m_Running.load() && m_QueuedCount.load(std::memory_order_acquire) == 0)
+				break;
+		}
+	}
+}
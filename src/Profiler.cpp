@@ -0,0 +1,201 @@
+// Profiler.cpp
+
+// SAGE Includes
+#include <SAGE/Profiler.hpp>
+// STL Includes
+#if defined SAGE_ENABLE_PROFILER
+	#include <algorithm>
+	#include <atomic>
+	#include <cstdio>
+	#include <memory>
+	#include <mutex>
+	#include <vector>
+#endif
+
+#if defined SAGE_ENABLE_PROFILER
+namespace
+{
+	struct ProfilerThread
+	{
+		int ID;
+		const char* Name;
+		std::atomic<Uint64> WriteIndex;
+		SAGE::ProfilerEvent Events[SAGE::Profiler::EventCapacity];
+	};
+
+	std::mutex sThreadMutex;
+	std::vector<std::unique_ptr<ProfilerThread>> sThreads;
+	std::atomic<Uint64> sFrameIndex(0);
+	std::atomic<Uint64> sFrameStarts[SAGE::Profiler::FrameCapacity];
+
+	thread_local ProfilerThread* sCurrentThread = nullptr;
+	thread_local int sCurrentDepth = 0;
+
+	// Rings are created once per thread and live until exit, so a trace can still include finished threads.
+	ProfilerThread& GetCurrentThread()
+	{
+		if (sCurrentThread == nullptr)
+		{
+			std::unique_ptr<ProfilerThread> thread(new ProfilerThread());
+			thread->Name = nullptr;
+			thread->WriteIndex = 0;
+
+			std::lock_guard<std::mutex> lock(sThreadMutex);
+			thread->ID = static_cast<int>(sThreads.size()) + 1;
+			sCurrentThread = thread.get();
+			sThreads.push_back(std::move(thread));
+		}
+
+		return *sCurrentThread;
+	}
+
+	void WriteEscaped(FILE* p_File, const char* p_String)
+	{
+		for (const char* ch = p_String; *ch != '\0'; ++ch)
+		{
+			if (*ch == '"' || *ch == '\\')
+				fputc('\\', p_File);
+
+			fputc(*ch, p_File);
+		}
+	}
+}
+#endif
+
+namespace SAGE
+{
+	bool Profiler::IsEnabled()
+	{
+#if defined SAGE_ENABLE_PROFILER
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void Profiler::MarkFrame()
+	{
+#if defined SAGE_ENABLE_PROFILER
+		Uint64 index = sFrameIndex.load(std::memory_order_relaxed);
+		sFrameStarts[index % FrameCapacity].store(SDL_GetPerformanceCounter(), std::memory_order_relaxed);
+		sFrameIndex.store(index + 1, std::memory_order_release);
+#endif
+	}
+
+	void Profiler::SetThreadName(const char* p_Name)
+	{
+#if defined SAGE_ENABLE_PROFILER
+		ProfilerThread& thread = GetCurrentThread();
+
+		std::lock_guard<std::mutex> lock(sThreadMutex);
+		thread.Name = p_Name;
+#endif
+	}
+
+	bool Profiler::WriteChromeTrace(const std::string& p_Filename, int p_FrameCount)
+	{
+#if defined SAGE_ENABLE_PROFILER
+		// The window runs from the start of the oldest requested frame to the start of the current one.
+		Uint64 frameIndex = sFrameIndex.load(std::memory_order_acquire);
+		if (frameIndex < 2 || p_FrameCount < 1)
+		{
+			SDL_Log("[Profiler::WriteChromeTrace] No complete frames have been recorded.");
+			return false;
+		}
+
+		Uint64 frameCount = static_cast<Uint64>(p_FrameCount);
+		if (frameCount > frameIndex - 1)
+			frameCount = frameIndex - 1;
+		if (frameCount > FrameCapacity - 1)
+			frameCount = FrameCapacity - 1;
+
+		Uint64 windowStart = sFrameStarts[(frameIndex - 1 - frameCount) % FrameCapacity].load(std::memory_order_relaxed);
+		Uint64 windowEnd = sFrameStarts[(frameIndex - 1) % FrameCapacity].load(std::memory_order_relaxed);
+
+		FILE* file = fopen(p_Filename.c_str(), "w");
+		if (file == nullptr)
+		{
+			SDL_Log("[Profiler::WriteChromeTrace] Failed to open '%s' for writing.", p_Filename.c_str());
+			return false;
+		}
+
+		double microsecondsPerTick = 1000000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+		bool first = true;
+
+		fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+		std::lock_guard<std::mutex> lock(sThreadMutex);
+		for (const std::unique_ptr<ProfilerThread>& thread : sThreads)
+		{
+			if (thread->Name != nullptr)
+			{
+				fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"", first ? "" : ",\n", thread->ID);
+				WriteEscaped(file, thread->Name);
+				fprintf(file, "\"}}");
+				first = false;
+			}
+
+			// Copy the live part of the ring, then drop anything the owner may have overwritten meanwhile.
+			Uint64 writeIndex = thread->WriteIndex.load(std::memory_order_acquire);
+			Uint64 readIndex = writeIndex > EventCapacity ? writeIndex - EventCapacity : 0;
+
+			std::vector<ProfilerEvent> events;
+			events.reserve(static_cast<size_t>(writeIndex - readIndex));
+			for (Uint64 i = readIndex; i < writeIndex; ++i)
+			{
+				events.push_back(thread->Events[i % EventCapacity]);
+			}
+
+			// The owner may already be writing event `overwritten`, into the slot of event `overwritten - EventCapacity`.
+			Uint64 overwritten = thread->WriteIndex.load(std::memory_order_acquire);
+			size_t firstValid = overwritten + 1 > EventCapacity + readIndex ? static_cast<size_t>(overwritten - EventCapacity + 1 - readIndex) : 0;
+			firstValid = std::min(firstValid, events.size());
+
+			for (size_t i = firstValid; i < events.size(); ++i)
+			{
+				const ProfilerEvent& event = events[i];
+				if (event.End < windowStart || event.Start > windowEnd)
+					continue;
+
+				fprintf(file, "%s{\"name\":\"", first ? "" : ",\n");
+				WriteEscaped(file, event.Name);
+				fprintf(file, "\",\"cat\":\"SAGE\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"depth\":%d}}",
+						thread->ID,
+						static_cast<Sint64>(event.Start - windowStart) * microsecondsPerTick,
+						(event.End - event.Start) * microsecondsPerTick,
+						event.Depth);
+				first = false;
+			}
+		}
+
+		fprintf(file, "\n]}\n");
+		fclose(file);
+
+		return true;
+#else
+		SDL_Log("[Profiler::WriteChromeTrace] The engine was built without SAGE_ENABLE_PROFILER.");
+		return false;
+#endif
+	}
+
+#if defined SAGE_ENABLE_PROFILER
+	void Profiler::Record(const char* p_Name, Uint64 p_Start, Uint64 p_End, int p_Depth)
+	{
+		ProfilerThread& thread = GetCurrentThread();
+
+		Uint64 index = thread.WriteIndex.load(std::memory_order_relaxed);
+		ProfilerEvent& event = thread.Events[index % EventCapacity];
+		event.Name = p_Name;
+		event.Start = p_Start;
+		event.End = p_End;
+		event.Depth = p_Depth;
+
+		thread.WriteIndex.store(index + 1, std::memory_order_release);
+	}
+
+	int& Profiler::GetDepth()
+	{
+		return sCurrentDepth;
+	}
+#endif
+}
@@ -0,0 +1,593 @@
+// RecordingRenderDevice.cpp
+
+// SAGE Includes
+#include <SAGE/RecordingRenderDevice.hpp>
+// STL Includes
+#include <cstdint>
+#include <cstring>
+
+namespace SAGE
+{
+	RecordingRenderDevice::RecordingRenderDevice()
+	{
+		m_CapturingPayloads = true;
+		m_NextName = 1;
+		m_ArrayBuffer = 0;
+		m_ElementArrayBuffer = 0;
+		m_PixelUnpackBuffer = 0;
+		m_OtherBuffer = 0;
+		m_VertexArray = 0;
+		m_Program = 0;
+		m_ActiveTexture = 0;
+
+		for (int i = 0; i < MaxTextureUnits; ++i)
+		{
+			m_Textures[i] = 0;
+		}
+	}
+
+	RecordingRenderDevice::~RecordingRenderDevice()
+	{
+	}
+
+	const std::vector<RenderCommand>& RecordingRenderDevice::GetCommands() const
+	{
+		return m_Commands;
+	}
+
+	int RecordingRenderDevice::GetCommandCount(RenderCommandType p_Type) const
+	{
+		int count = 0;
+
+		for (const RenderCommand& command : m_Commands)
+		{
+			if (command.Type == p_Type)
+				count++;
+		}
+
+		return count;
+	}
+
+	int RecordingRenderDevice::GetDrawCallCount() const
+	{
+		return GetCommandCount(RenderCommandType::DrawElements) +
+			   GetCommandCount(RenderCommandType::DrawElementsBaseVertex) +
+			   GetCommandCount(RenderCommandType::DrawArraysInstanced);
+	}
+
+	const std::vector<unsigned char>& RecordingRenderDevice::GetBufferContents(GLuint p_Buffer) const
+	{
+		static const std::vector<unsigned char> sEmpty;
+
+		auto iterator = m_BufferContents.find(p_Buffer);
+		if (iterator == m_BufferContents.end())
+			return sEmpty;
+
+		return iterator->second;
+	}
+
+	bool RecordingRenderDevice::IsCapturingPayloads() const
+	{
+		return m_CapturingPayloads;
+	}
+
+	void RecordingRenderDevice::SetCapturingPayloads(bool p_Capturing)
+	{
+		m_CapturingPayloads = p_Capturing;
+	}
+
+	void RecordingRenderDevice::ClearCommands()
+	{
+		m_Commands.clear();
+	}
+
+	bool RecordingRenderDevice::Initialize()
+	{
+		return true;
+	}
+
+	bool RecordingRenderDevice::SupportsBufferStorage() const
+	{
+		return true;
+	}
+
+	void RecordingRenderDevice::GenBuffers(GLsizei p_Count, GLuint* p_Buffers)
+	{
+		GenerateNames(p_Count, p_Buffers);
+
+		for (GLsizei i = 0; i < p_Count; ++i)
+		{
+			m_BufferContents[p_Buffers[i]];
+		}
+
+		Record(RenderCommandType::GenBuffers, 0, p_Count > 0 ? p_Buffers[0] : 0, p_Count);
+	}
+
+	void RecordingRenderDevice::DeleteBuffers(GLsizei p_Count, const GLuint* p_Buffers)
+	{
+		for (GLsizei i = 0; i < p_Count; ++i)
+		{
+			m_BufferContents.erase(p_Buffers[i]);
+
+			if (m_ArrayBuffer == p_Buffers[i])
+				m_ArrayBuffer = 0;
+			if (m_ElementArrayBuffer == p_Buffers[i])
+				m_ElementArrayBuffer = 0;
+		}
+
+		Record(RenderCommandType::DeleteBuffers, 0, p_Count > 0 ? p_Buffers[0] : 0, p_Count);
+	}
+
+	void RecordingRenderDevice::BindBuffer(GLenum p_Target, GLuint p_Buffer)
+	{
+		GetBufferBinding(p_Target) = p_Buffer;
+
+		// The element array binding is part of the vertex array's state.
+		if (p_Target == GL_ELEMENT_ARRAY_BUFFER)
+			m_VertexArrayElementBuffers[m_VertexArray] = p_Buffer;
+
+		Record(RenderCommandType::BindBuffer, p_Target, p_Buffer);
+	}
+
+	void RecordingRenderDevice::BufferData(GLenum p_Target, GLsizeiptr p_Size, const void* p_Data, GLenum p_Usage)
+	{
+		GLuint buffer = GetBufferBinding(p_Target);
+
+		std::vector<unsigned char>& contents = m_BufferContents[buffer];
+		contents.assign(static_cast<size_t>(p_Size), 0);
+		if (p_Data != nullptr && p_Size > 0)
+			std::memcpy(&contents.front(), p_Data, static_cast<size_t>(p_Size));
+
+		RenderCommand& command = Record(RenderCommandType::BufferData, p_Target, buffer, p_Size, p_Usage);
+		CapturePayload(command, p_Data, static_cast<size_t>(p_Size));
+	}
+
+	void RecordingRenderDevice::BufferSubData(GLenum p_Target, GLintptr p_Offset, GLsizeiptr p_Size, const void* p_Data)
+	{
+		GLuint buffer = GetBufferBinding(p_Target);
+
+		std::vector<unsigned char>& contents = m_BufferContents[buffer];
+		if (contents.size() < static_cast<size_t>(p_Offset + p_Size))
+			contents.resize(static_cast<size_t>(p_Offset + p_Size));
+		if (p_Data != nullptr && p_Size > 0)
+			std::memcpy(&contents[static_cast<size_t>(p_Offset)], p_Data, static_cast<size_t>(p_Size));
+
+		RenderCommand& command = Record(RenderCommandType::BufferSubData, p_Target, buffer, p_Offset, p_Size);
+		CapturePayload(command, p_Data, static_cast<size_t>(p_Size));
+	}
+
+	void RecordingRenderDevice::BufferStorage(GLenum p_Target, GLsizeiptr p_Size, const void* p_Data, GLbitfield p_Flags)
+	{
+		GLuint buffer = GetBufferBinding(p_Target);
+
+		std::vector<unsigned char>& contents = m_BufferContents[buffer];
+		contents.assign(static_cast<size_t>(p_Size), 0);
+		if (p_Data != nullptr && p_Size > 0)
+			std::memcpy(&contents.front(), p_Data, static_cast<size_t>(p_Size));
+
+		RenderCommand& command = Record(RenderCommandType::BufferStorage, p_Target, buffer, p_Size, p_Flags);
+		CapturePayload(command, p_Data, static_cast<size_t>(p_Size));
+	}
+
+	void* RecordingRenderDevice::MapBufferRange(GLenum p_Target, GLintptr p_Offset, GLsizeiptr p_Length, GLbitfield p_Access)
+	{
+		GLuint buffer = GetBufferBinding(p_Target);
+		Record(RenderCommandType::MapBufferRange, p_Target, buffer, p_Offset, p_Length, p_Access);
+
+		// Writes through the mapping land directly in the recorded contents.
+		std::vector<unsigned char>& contents = m_BufferContents[buffer];
+		if (contents.size() < static_cast<size_t>(p_Offset + p_Length) || p_Length == 0)
+			return nullptr;
+
+		return &contents[static_cast<size_t>(p_Offset)];
+	}
+
+	GLboolean RecordingRenderDevice::UnmapBuffer(GLenum p_Target)
+	{
+		Record(RenderCommandType::UnmapBuffer, p_Target, GetBufferBinding(p_Target));
+
+		return GL_TRUE;
+	}
+
+	void RecordingRenderDevice::GenVertexArrays(GLsizei p_Count, GLuint* p_Arrays)
+	{
+		GenerateNames(p_Count, p_Arrays);
+
+		Record(RenderCommandType::GenVertexArrays, 0, p_Count > 0 ? p_Arrays[0] : 0, p_Count);
+	}
+
+	void RecordingRenderDevice::DeleteVertexArrays(GLsizei p_Count, const GLuint* p_Arrays)
+	{
+		for (GLsizei i = 0; i < p_Count; ++i)
+		{
+			m_VertexArrayElementBuffers.erase(p_Arrays[i]);
+
+			if (m_VertexArray == p_Arrays[i])
+			{
+				m_VertexArray = 0;
+				m_ElementArrayBuffer = m_VertexArrayElementBuffers[0];
+			}
+		}
+
+		Record(RenderCommandType::DeleteVertexArrays, 0, p_Count > 0 ? p_Arrays[0] : 0, p_Count);
+	}
+
+	void RecordingRenderDevice::BindVertexArray(GLuint p_Array)
+	{
+		m_VertexArray = p_Array;
+		m_ElementArrayBuffer = m_VertexArrayElementBuffers[p_Array];
+
+		Record(RenderCommandType::BindVertexArray, 0, p_Array);
+	}
+
+	void RecordingRenderDevice::EnableVertexAttribArray(GLuint p_Index)
+	{
+		Record(RenderCommandType::EnableVertexAttribArray, 0, m_VertexArray, p_Index);
+	}
+
+	void RecordingRenderDevice::VertexAttribPointer(GLuint p_Index, GLint p_Size, GLenum p_Type, GLboolean p_Normalized, GLsizei p_Stride, const void* p_Offset)
+	{
+		Record(RenderCommandType::VertexAttribPointer, p_Type, m_VertexArray, p_Index, p_Size, p_Stride, reinterpret_cast<GLint64>(p_Offset));
+	}
+
+	void RecordingRenderDevice::VertexAttribIPointer(GLuint p_Index, GLint p_Size, GLenum p_Type, GLsizei p_Stride, const void* p_Offset)
+	{
+		Record(RenderCommandType::VertexAttribIPointer, p_Type, m_VertexArray, p_Index, p_Size, p_Stride, reinterpret_cast<GLint64>(p_Offset));
+	}
+
+	void RecordingRenderDevice::VertexAttribDivisor(GLuint p_Index, GLuint p_Divisor)
+	{
+		Record(RenderCommandType::VertexAttribDivisor, 0, m_VertexArray, p_Index, p_Divisor);
+	}
+
+	void RecordingRenderDevice::GenTextures(GLsizei p_Count, GLuint* p_Textures)
+	{
+		GenerateNames(p_Count, p_Textures);
+
+		Record(RenderCommandType::GenTextures, 0, p_Count > 0 ? p_Textures[0] : 0, p_Count);
+	}
+
+	void RecordingRenderDevice::DeleteTextures(GLsizei p_Count, const GLuint* p_Textures)
+	{
+		for (GLsizei i = 0; i < p_Count; ++i)
+		{
+			for (int j = 0; j < MaxTextureUnits; ++j)
+			{
+				if (m_Textures[j] == p_Textures[i])
+					m_Textures[j] = 0;
+			}
+		}
+
+		Record(RenderCommandType::DeleteTextures, 0, p_Count > 0 ? p_Textures[0] : 0, p_Count);
+	}
+
+	void RecordingRenderDevice::ActiveTexture(GLenum p_Unit)
+	{
+		m_ActiveTexture = static_cast<int>(p_Unit - GL_TEXTURE0);
+
+		Record(RenderCommandType::ActiveTexture, p_Unit);
+	}
+
+	void RecordingRenderDevice::BindTexture(GLenum p_Target, GLuint p_Texture)
+	{
+		if (m_ActiveTexture >= 0 && m_ActiveTexture < MaxTextureUnits)
+			m_Textures[m_ActiveTexture] = p_Texture;
+
+		Record(RenderCommandType::BindTexture, p_Target, p_Texture, m_ActiveTexture);
+	}
+
+	void RecordingRenderDevice::TexImage2D(GLenum p_Target, GLint p_Level, GLint p_InternalFormat, GLsizei p_Width, GLsizei p_Height, GLint p_Border, GLenum p_Format, GLenum p_Type, const void* p_Pixels)
+	{
+		RenderCommand& command = Record(RenderCommandType::TexImage2D, p_Target, GetBoundTexture(), p_Width, p_Height, p_InternalFormat, p_Format);
+
+		// Only byte formats the engine uploads are sized; anything else is recorded without pixels.
+		size_t bytesPerPixel = 0;
+		if (p_Type == GL_UNSIGNED_BYTE)
+			bytesPerPixel = p_Format == GL_RGBA ? 4 : (p_Format == GL_RGB ? 3 : 0);
+
+		CapturePayload(command, p_Pixels, static_cast<size_t>(p_Width) * static_cast<size_t>(p_Height) * bytesPerPixel);
+	}
+
+	void RecordingRenderDevice::TexSubImage2D(GLenum p_Target, GLint p_Level, GLint p_X, GLint p_Y, GLsizei p_Width, GLsizei p_Height, GLenum p_Format, GLenum p_Type, const void* p_Pixels)
+	{
+		RenderCommand& command = Record(RenderCommandType::TexSubImage2D, p_Target, GetBoundTexture(), p_X, p_Y, p_Width, p_Height);
+
+		size_t bytesPerPixel = 0;
+		if (p_Type == GL_UNSIGNED_BYTE)
+			bytesPerPixel = p_Format == GL_RGBA ? 4 : (p_Format == GL_RGB ? 3 : 0);
+
+		size_t size = static_cast<size_t>(p_Width) * static_cast<size_t>(p_Height) * bytesPerPixel;
+
+		// With an unpack buffer bound, the pointer is an offset into that buffer's contents.
+		if (m_PixelUnpackBuffer != 0)
+		{
+			const std::vector<unsigned char>& contents = m_BufferContents[m_PixelUnpackBuffer];
+			size_t offset = static_cast<size_t>(reinterpret_cast<uintptr_t>(p_Pixels));
+			if (offset + size <= contents.size())
+				CapturePayload(command, contents.data() + offset, size);
+
+			return;
+		}
+
+		CapturePayload(command, p_Pixels, size);
+	}
+
+	void RecordingRenderDevice::TexParameteri(GLenum p_Target, GLenum p_Name, GLint p_Value)
+	{
+		Record(RenderCommandType::TexParameter, p_Name, GetBoundTexture(), p_Value);
+	}
+
+	void RecordingRenderDevice::TexParameterfv(GLenum p_Target, GLenum p_Name, const GLfloat* p_Values)
+	{
+		RenderCommand& command = Record(RenderCommandType::TexParameter, p_Name, GetBoundTexture());
+		CapturePayload(command, p_Values, 4 * sizeof(GLfloat));
+	}
+
+	GLuint RecordingRenderDevice::CreateShader(GLenum p_Type)
+	{
+		GLuint shader = 0;
+		GenerateNames(1, &shader);
+
+		Record(RenderCommandType::CreateShader, p_Type, shader);
+
+		return shader;
+	}
+
+	void RecordingRenderDevice::ShaderSource(GLuint p_Shader, GLsizei p_Count, const GLchar* const* p_Sources, const GLint* p_Lengths)
+	{
+	}
+
+	void RecordingRenderDevice::CompileShader(GLuint p_Shader)
+	{
+		Record(RenderCommandType::CompileShader, 0, p_Shader);
+	}
+
+	void RecordingRenderDevice::GetShaderiv(GLuint p_Shader, GLenum p_Name, GLint* p_Value)
+	{
+		// Every shader compiles, with an empty log.
+		*p_Value = p_Name == GL_COMPILE_STATUS ? GL_TRUE : 0;
+	}
+
+	void RecordingRenderDevice::GetShaderInfoLog(GLuint p_Shader, GLsizei p_MaxLength, GLsizei* p_Length, GLchar* p_Log)
+	{
+		if (p_Length != nullptr)
+			*p_Length = 0;
+		if (p_Log != nullptr && p_MaxLength > 0)
+			p_Log[0] = '\0';
+	}
+
+	void RecordingRenderDevice::DeleteShader(GLuint p_Shader)
+	{
+		Record(RenderCommandType::DeleteShader, 0, p_Shader);
+	}
+
+	GLuint RecordingRenderDevice::CreateProgram()
+	{
+		GLuint program = 0;
+		GenerateNames(1, &program);
+
+		Record(RenderCommandType::CreateProgram, 0, program);
+
+		return program;
+	}
+
+	void RecordingRenderDevice::AttachShader(GLuint p_Program, GLuint p_Shader)
+	{
+		Record(RenderCommandType::AttachShader, 0, p_Program, p_Shader);
+	}
+
+	void RecordingRenderDevice::LinkProgram(GLuint p_Program)
+	{
+		Record(RenderCommandType::LinkProgram, 0, p_Program);
+	}
+
+	void RecordingRenderDevice::GetProgramiv(GLuint p_Program, GLenum p_Name, GLint* p_Value)
+	{
+		// Every program links and reports no active uniforms.
+		*p_Value = p_Name == GL_LINK_STATUS ? GL_TRUE : 0;
+	}
+
+	void RecordingRenderDevice::GetProgramInfoLog(GLuint p_Program, GLsizei p_MaxLength, GLsizei* p_Length, GLchar* p_Log)
+	{
+		if (p_Length != nullptr)
+			*p_Length = 0;
+		if (p_Log != nullptr && p_MaxLength > 0)
+			p_Log[0] = '\0';
+	}
+
+	void RecordingRenderDevice::GetActiveUniform(GLuint p_Program, GLuint p_Index, GLsizei p_MaxLength, GLsizei* p_Length, GLint* p_Size, GLenum* p_Type, GLchar* p_Name)
+	{
+		if (p_Length != nullptr)
+			*p_Length = 0;
+		if (p_Size != nullptr)
+			*p_Size = 0;
+		if (p_Type != nullptr)
+			*p_Type = GL_NONE;
+		if (p_Name != nullptr && p_MaxLength > 0)
+			p_Name[0] = '\0';
+	}
+
+	void RecordingRenderDevice::DeleteProgram(GLuint p_Program)
+	{
+		if (m_Program == p_Program)
+			m_Program = 0;
+
+		Record(RenderCommandType::DeleteProgram, 0, p_Program);
+	}
+
+	void RecordingRenderDevice::UseProgram(GLuint p_Program)
+	{
+		m_Program = p_Program;
+
+		Record(RenderCommandType::UseProgram, 0, p_Program);
+	}
+
+	GLint RecordingRenderDevice::GetUniformLocation(GLuint p_Program, const GLchar* p_Name)
+	{
+		// Hand out a stable location per program and name.
+		std::pair<GLuint, std::string> key(p_Program, p_Name);
+
+		auto iterator = m_UniformLocations.find(key);
+		if (iterator != m_UniformLocations.end())
+			return iterator->second;
+
+		GLint location = static_cast<GLint>(m_UniformLocations.size());
+		m_UniformLocations[key] = location;
+
+		return location;
+	}
+
+	void RecordingRenderDevice::Uniform1i(GLint p_Location, GLint p_Value)
+	{
+		Record(RenderCommandType::Uniform, 0, m_Program, p_Location, p_Value);
+	}
+
+	void RecordingRenderDevice::Uniform1f(GLint p_Location, GLfloat p_Value)
+	{
+		RenderCommand& command = Record(RenderCommandType::Uniform, 0, m_Program, p_Location);
+		CapturePayload(command, &p_Value, sizeof(GLfloat));
+	}
+
+	void RecordingRenderDevice::UniformMatrix4fv(GLint p_Location, GLsizei p_Count, GLboolean p_Transpose, const GLfloat* p_Values)
+	{
+		RenderCommand& command = Record(RenderCommandType::Uniform, 0, m_Program, p_Location, p_Count);
+		CapturePayload(command, p_Values, static_cast<size_t>(p_Count) * 16 * sizeof(GLfloat));
+	}
+
+	void RecordingRenderDevice::Enable(GLenum p_Capability)
+	{
+		Record(RenderCommandType::Enable, p_Capability);
+	}
+
+	void RecordingRenderDevice::Disable(GLenum p_Capability)
+	{
+		Record(RenderCommandType::Disable, p_Capability);
+	}
+
+	void RecordingRenderDevice::BlendFunc(GLenum p_Source, GLenum p_Destination)
+	{
+		Record(RenderCommandType::BlendFunc, 0, 0, p_Source, p_Destination);
+	}
+
+	void RecordingRenderDevice::CullFace(GLenum p_Face)
+	{
+		Record(RenderCommandType::CullFace, p_Face);
+	}
+
+	void RecordingRenderDevice::Viewport(GLint p_X, GLint p_Y, GLsizei p_Width, GLsizei p_Height)
+	{
+		Record(RenderCommandType::Viewport, 0, 0, p_X, p_Y, p_Width, p_Height);
+	}
+
+	void RecordingRenderDevice::ClearColor(GLfloat p_Red, GLfloat p_Green, GLfloat p_Blue, GLfloat p_Alpha)
+	{
+		GLfloat color[4] = { p_Red, p_Green, p_Blue, p_Alpha };
+
+		RenderCommand& command = Record(RenderCommandType::ClearColor);
+		CapturePayload(command, color, sizeof(color));
+	}
+
+	void RecordingRenderDevice::Clear(GLbitfield p_Mask)
+	{
+		Record(RenderCommandType::Clear, 0, 0, p_Mask);
+	}
+
+	void RecordingRenderDevice::DrawElements(GLenum p_Mode, GLsizei p_Count, GLenum p_Type, const void* p_Indices)
+	{
+		Record(RenderCommandType::DrawElements, p_Mode, m_VertexArray, p_Count, p_Type, reinterpret_cast<GLint64>(p_Indices));
+	}
+
+	void RecordingRenderDevice::DrawElementsBaseVertex(GLenum p_Mode, GLsizei p_Count, GLenum p_Type, const void* p_Indices, GLint p_BaseVertex)
+	{
+		Record(RenderCommandType::DrawElementsBaseVertex, p_Mode, m_VertexArray, p_Count, p_Type, reinterpret_cast<GLint64>(p_Indices), p_BaseVertex);
+	}
+
+	void RecordingRenderDevice::DrawArraysInstanced(GLenum p_Mode, GLint p_First, GLsizei p_Count, GLsizei p_InstanceCount)
+	{
+		Record(RenderCommandType::DrawArraysInstanced, p_Mode, m_VertexArray, p_First, p_Count, p_InstanceCount);
+	}
+
+	GLsync RecordingRenderDevice::FenceSync(GLenum p_Condition, GLbitfield p_Flags)
+	{
+		// Fences are never waited on for real, so any unique non-null handle will do.
+		GLuint name = 0;
+		GenerateNames(1, &name);
+
+		Record(RenderCommandType::FenceSync, p_Condition, name);
+
+		return reinterpret_cast<GLsync>(static_cast<uintptr_t>(name));
+	}
+
+	GLenum RecordingRenderDevice::ClientWaitSync(GLsync p_Sync, GLbitfield p_Flags, GLuint64 p_Timeout)
+	{
+		Record(RenderCommandType::ClientWaitSync, 0, static_cast<GLuint>(reinterpret_cast<uintptr_t>(p_Sync)), p_Flags);
+
+		return GL_ALREADY_SIGNALED;
+	}
+
+	void RecordingRenderDevice::DeleteSync(GLsync p_Sync)
+	{
+		Record(RenderCommandType::DeleteSync, 0, static_cast<GLuint>(reinterpret_cast<uintptr_t>(p_Sync)));
+	}
+
+	void RecordingRenderDevice::Flush()
+	{
+		Record(RenderCommandType::Flush, 0, 0);
+	}
+
+	RenderCommand& RecordingRenderDevice::Record(RenderCommandType p_Type, GLenum p_Target, GLuint p_Object, GLint64 p_A, GLint64 p_B, GLint64 p_C, GLint64 p_D)
+	{
+		m_Commands.push_back(RenderCommand());
+
+		RenderCommand& command = m_Commands.back();
+		command.Type = p_Type;
+		command.Target = p_Target;
+		command.Object = p_Object;
+		command.Arguments[0] = p_A;
+		command.Arguments[1] = p_B;
+		command.Arguments[2] = p_C;
+		command.Arguments[3] = p_D;
+
+		return command;
+	}
+
+	void RecordingRenderDevice::CapturePayload(RenderCommand& p_Command, const void* p_Data, size_t p_Size)
+	{
+		if (!m_CapturingPayloads || p_Data == nullptr || p_Size == 0)
+			return;
+
+		const unsigned char* bytes = static_cast<const unsigned char*>(p_Data);
+		p_Command.Payload.assign(bytes, bytes + p_Size);
+	}
+
+	void RecordingRenderDevice::GenerateNames(GLsizei p_Count, GLuint* p_Names)
+	{
+		for (GLsizei i = 0; i < p_Count; ++i)
+		{
+			p_Names[i] = m_NextName++;
+		}
+	}
+
+	GLuint& RecordingRenderDevice::GetBufferBinding(GLenum p_Target)
+	{
+		switch (p_Target)
+		{
+			case GL_ARRAY_BUFFER:
+				return m_ArrayBuffer;
+			case GL_ELEMENT_ARRAY_BUFFER:
+				return m_ElementArrayBuffer;
+			case GL_PIXEL_UNPACK_BUFFER:
+				return m_PixelUnpackBuffer;
+			default:
+				return m_OtherBuffer;
+		}
+	}
+
+	GLuint RecordingRenderDevice::GetBoundTexture() const
+	{
+		if (m_ActiveTexture < 0 || m_ActiveTexture >= MaxTextureUnits)
+			return 0;
+
+		return m_Textures[m_ActiveTexture];
+	}
+}
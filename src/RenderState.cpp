@@ -0,0 +1,222 @@
+// RenderState.cpp
+
+// SAGE Includes
+#include <SAGE/IRenderDevice.hpp>
+#include <SAGE/RenderState.hpp>
+
+namespace SAGE
+{
+	thread_local GLuint RenderState::sProgram = RenderState::UnknownBinding;
+	thread_local GLuint RenderState::sVertexArray = RenderState::UnknownBinding;
+	thread_local GLuint RenderState::sArrayBuffer = RenderState::UnknownBinding;
+	thread_local GLuint RenderState::sElementArrayBuffer = RenderState::UnknownBinding;
+	thread_local int RenderState::sActiveTexture = -1;
+	thread_local GLuint RenderState::sTextures[RenderState::MaxTextureUnits];
+	thread_local int RenderState::sBlendEnabled = -1;
+	thread_local GLenum RenderState::sBlendSource = GL_NONE;
+	thread_local GLenum RenderState::sBlendDestination = GL_NONE;
+	thread_local int RenderState::sCullEnabled = -1;
+	thread_local GLenum RenderState::sCullFace = GL_NONE;
+	thread_local int RenderState::sIssuedCallCount = 0;
+	thread_local int RenderState::sSkippedCallCount = 0;
+	thread_local int RenderState::sTextureBindCount = 0;
+
+	void RenderState::Reset()
+	{
+		sProgram = UnknownBinding;
+		sVertexArray = UnknownBinding;
+		sArrayBuffer = UnknownBinding;
+		sElementArrayBuffer = UnknownBinding;
+		sActiveTexture = -1;
+
+		for (int i = 0; i < MaxTextureUnits; ++i)
+		{
+			sTextures[i] = UnknownBinding;
+		}
+
+		sBlendEnabled = -1;
+		sBlendSource = GL_NONE;
+		sBlendDestination = GL_NONE;
+		sCullEnabled = -1;
+		sCullFace = GL_NONE;
+	}
+
+	void RenderState::UseProgram(GLuint p_Program)
+	{
+		if (Skip(sProgram == p_Program))
+			return;
+
+		IRenderDevice::Get().UseProgram(p_Program);
+		sProgram = p_Program;
+	}
+
+	void RenderState::BindVertexArray(GLuint p_VertexArray)
+	{
+		if (Skip(sVertexArray == p_VertexArray))
+			return;
+
+		IRenderDevice::Get().BindVertexArray(p_VertexArray);
+		sVertexArray = p_VertexArray;
+
+		// The element array binding belongs to the vertex array.
+		sElementArrayBuffer = UnknownBinding;
+	}
+
+	void RenderState::BindBuffer(GLenum p_Target, GLuint p_Buffer)
+	{
+		GLuint* shadow = nullptr;
+
+		switch (p_Target)
+		{
+			case GL_ARRAY_BUFFER:
+				shadow = &sArrayBuffer;
+				break;
+			case GL_ELEMENT_ARRAY_BUFFER:
+				shadow = &sElementArrayBuffer;
+				break;
+		}
+
+		// Targets that aren't shadowed always go through.
+		if (shadow != nullptr && Skip(*shadow == p_Buffer))
+			return;
+
+		IRenderDevice::Get().BindBuffer(p_Target, p_Buffer);
+		if (shadow != nullptr)
+			*shadow = p_Buffer;
+	}
+
+	void RenderState::BindTexture(int p_Unit, GLuint p_Texture)
+	{
+		if (p_Unit < 0 || p_Unit >= MaxTextureUnits)
+		{
+			SetActiveTexture(p_Unit);
+			IRenderDevice::Get().BindTexture(GL_TEXTURE_2D, p_Texture);
+			sIssuedCallCount++;
+			sTextureBindCount++;
+			return;
+		}
+
+		if (Skip(sTextures[p_Unit] == p_Texture))
+			return;
+
+		SetActiveTexture(p_Unit);
+		IRenderDevice::Get().BindTexture(GL_TEXTURE_2D, p_Texture);
+		sTextures[p_Unit] = p_Texture;
+		sTextureBindCount++;
+	}
+
+	void RenderState::SetBlend(bool p_Enabled, GLenum p_Source, GLenum p_Destination)
+	{
+		if (!Skip(sBlendEnabled == (int)p_Enabled))
+		{
+			if (p_Enabled)
+				IRenderDevice::Get().Enable(GL_BLEND);
+			else
+				IRenderDevice::Get().Disable(GL_BLEND);
+
+			sBlendEnabled = p_Enabled;
+		}
+
+		// The blend function only matters while blending is enabled.
+		if (!p_Enabled)
+			return;
+
+		if (Skip(sBlendSource == p_Source && sBlendDestination == p_Destination))
+			return;
+
+		IRenderDevice::Get().BlendFunc(p_Source, p_Destination);
+		sBlendSource = p_Source;
+		sBlendDestination = p_Destination;
+	}
+
+	void RenderState::SetCulling(bool p_Enabled, GLenum p_Face)
+	{
+		if (!Skip(sCullEnabled == (int)p_Enabled))
+		{
+			if (p_Enabled)
+				IRenderDevice::Get().Enable(GL_CULL_FACE);
+			else
+				IRenderDevice::Get().Disable(GL_CULL_FACE);
+
+			sCullEnabled = p_Enabled;
+		}
+
+		// The cull face only matters while culling is enabled.
+		if (!p_Enabled)
+			return;
+
+		if (Skip(sCullFace == p_Face))
+			return;
+
+		IRenderDevice::Get().CullFace(p_Face);
+		sCullFace = p_Face;
+	}
+
+	void RenderState::ForgetVertexArray(GLuint p_VertexArray)
+	{
+		// Deleting a bound object reverts its binding to zero.
+		if (sVertexArray == p_VertexArray)
+		{
+			sVertexArray = 0;
+			sElementArrayBuffer = UnknownBinding;
+		}
+	}
+
+	void RenderState::ForgetBuffer(GLuint p_Buffer)
+	{
+		if (sArrayBuffer == p_Buffer)
+			sArrayBuffer = 0;
+		if (sElementArrayBuffer == p_Buffer)
+			sElementArrayBuffer = 0;
+	}
+
+	void RenderState::ForgetTexture(GLuint p_Texture)
+	{
+		for (int i = 0; i < MaxTextureUnits; ++i)
+		{
+			if (sTextures[i] == p_Texture)
+				sTextures[i] = 0;
+		}
+	}
+
+	int RenderState::GetIssuedCallCount()
+	{
+		return sIssuedCallCount;
+	}
+
+	int RenderState::GetSkippedCallCount()
+	{
+		return sSkippedCallCount;
+	}
+
+	int RenderState::GetTextureBindCount()
+	{
+		return sTextureBindCount;
+	}
+
+	void RenderState::ResetCallCounts()
+	{
+		sIssuedCallCount = 0;
+		sSkippedCallCount = 0;
+		sTextureBindCount = 0;
+	}
+
+	void RenderState::SetActiveTexture(int p_Unit)
+	{
+		if (Skip(sActiveTexture == p_Unit))
+			return;
+
+		IRenderDevice::Get().ActiveTexture(GL_TEXTURE0 + p_Unit);
+		sActiveTexture = p_Unit;
+	}
+
+	bool RenderState::Skip(bool p_Redundant)
+	{
+		if (p_Redundant)
+			sSkippedCallCount++;
+		else
+			sIssuedCallCount++;
+
+		return p_Redundant;
+	}
+}
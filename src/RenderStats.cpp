@@ -0,0 +1,167 @@
+// RenderStats.cpp
+
+// SAGE Includes
+#include <SAGE/RenderStats.hpp>
+// STL Includes
+#include <algorithm>
+
+namespace SAGE
+{
+	RenderStats& RenderStats::operator+=(const RenderStats& p_Other)
+	{
+		DrawCalls += p_Other.DrawCalls;
+		Quads += p_Other.Quads;
+		Triangles += p_Other.Triangles;
+		Vertices += p_Other.Vertices;
+		UploadedBytes += p_Other.UploadedBytes;
+		TextureSwitches += p_Other.TextureSwitches;
+		StateChanges += p_Other.StateChanges;
+		CapacityFlushes += p_Other.CapacityFlushes;
+		TextureFlushes += p_Other.TextureFlushes;
+		SortMilliseconds += p_Other.SortMilliseconds;
+
+		return *this;
+	}
+
+	RenderStatsHistory::RenderStatsHistory(int p_WindowSize)
+	{
+		m_Next = 0;
+		m_FrameCount = 0;
+
+		SetWindowSize(p_WindowSize);
+	}
+
+	RenderStatsHistory::~RenderStatsHistory()
+	{
+	}
+
+	int RenderStatsHistory::GetWindowSize() const
+	{
+		return (int)m_Frames.size();
+	}
+
+	int RenderStatsHistory::GetFrameCount() const
+	{
+		return m_FrameCount;
+	}
+
+	const RenderStats& RenderStatsHistory::GetLatest() const
+	{
+		// An empty history reads as a cleared frame.
+		int index = (m_Next + (int)m_Frames.size() - 1) % (int)m_Frames.size();
+
+		return m_Frames[index];
+	}
+
+	RenderStats RenderStatsHistory::GetMinimum() const
+	{
+		RenderStats minimum;
+		if (m_FrameCount == 0)
+			return minimum;
+
+		minimum = m_Frames[0];
+		for (int i = 1; i < m_FrameCount; ++i)
+		{
+			const RenderStats& frame = m_Frames[i];
+
+			minimum.DrawCalls = std::min(minimum.DrawCalls, frame.DrawCalls);
+			minimum.Quads = std::min(minimum.Quads, frame.Quads);
+			minimum.Triangles = std::min(minimum.Triangles, frame.Triangles);
+			minimum.Vertices = std::min(minimum.Vertices, frame.Vertices);
+			minimum.UploadedBytes = std::min(minimum.UploadedBytes, frame.UploadedBytes);
+			minimum.TextureSwitches = std::min(minimum.TextureSwitches, frame.TextureSwitches);
+			minimum.StateChanges = std::min(minimum.StateChanges, frame.StateChanges);
+			minimum.CapacityFlushes = std::min(minimum.CapacityFlushes, frame.CapacityFlushes);
+			minimum.TextureFlushes = std::min(minimum.TextureFlushes, frame.TextureFlushes);
+			minimum.SortMilliseconds = std::min(minimum.SortMilliseconds, frame.SortMilliseconds);
+		}
+
+		return minimum;
+	}
+
+	RenderStats RenderStatsHistory::GetAverage() const
+	{
+		RenderStats average;
+		if (m_FrameCount == 0)
+			return average;
+
+		// Sum in doubles so long windows of large counts don't overflow.
+		double sums[10] = { 0.0 };
+		for (int i = 0; i < m_FrameCount; ++i)
+		{
+			const RenderStats& frame = m_Frames[i];
+
+			sums[0] += frame.DrawCalls;
+			sums[1] += frame.Quads;
+			sums[2] += frame.Triangles;
+			sums[3] += frame.Vertices;
+			sums[4] += frame.UploadedBytes;
+			sums[5] += frame.TextureSwitches;
+			sums[6] += frame.StateChanges;
+			sums[7] += frame.CapacityFlushes;
+			sums[8] += frame.TextureFlushes;
+			sums[9] += frame.SortMilliseconds;
+		}
+
+		average.DrawCalls = (int)(sums[0] / m_FrameCount + 0.5);
+		average.Quads = (int)(sums[1] / m_FrameCount + 0.5);
+		average.Triangles = (int)(sums[2] / m_FrameCount + 0.5);
+		average.Vertices = (int)(sums[3] / m_FrameCount + 0.5);
+		average.UploadedBytes = (int)(sums[4] / m_FrameCount + 0.5);
+		average.TextureSwitches = (int)(sums[5] / m_FrameCount + 0.5);
+		average.StateChanges = (int)(sums[6] / m_FrameCount + 0.5);
+		average.CapacityFlushes = (int)(sums[7] / m_FrameCount + 0.5);
+		average.TextureFlushes = (int)(sums[8] / m_FrameCount + 0.5);
+		average.SortMilliseconds = (float)(sums[9] / m_FrameCount);
+
+		return average;
+	}
+
+	RenderStats RenderStatsHistory::GetMaximum() const
+	{
+		RenderStats maximum;
+
+		for (int i = 0; i < m_FrameCount; ++i)
+		{
+			const RenderStats& frame = m_Frames[i];
+
+			maximum.DrawCalls = std::max(maximum.DrawCalls, frame.DrawCalls);
+			maximum.Quads = std::max(maximum.Quads, frame.Quads);
+			maximum.Triangles = std::max(maximum.Triangles, frame.Triangles);
+			maximum.Vertices = std::max(maximum.Vertices, frame.Vertices);
+			maximum.UploadedBytes = std::max(maximum.UploadedBytes, frame.UploadedBytes);
+			maximum.TextureSwitches = std::max(maximum.TextureSwitches, frame.TextureSwitches);
+			maximum.StateChanges = std::max(maximum.StateChanges, frame.StateChanges);
+			maximum.CapacityFlushes = std::max(maximum.CapacityFlushes, frame.CapacityFlushes);
+			maximum.TextureFlushes = std::max(maximum.TextureFlushes, frame.TextureFlushes);
+			maximum.SortMilliseconds = std::max(maximum.SortMilliseconds, frame.SortMilliseconds);
+		}
+
+		return maximum;
+	}
+
+	void RenderStatsHistory::SetWindowSize(int p_WindowSize)
+	{
+		m_Frames.assign(std::max(1, p_WindowSize), RenderStats());
+
+		Clear();
+	}
+
+	void RenderStatsHistory::Push(const RenderStats& p_Stats)
+	{
+		m_Frames[m_Next] = p_Stats;
+		m_Next = (m_Next + 1) % (int)m_Frames.size();
+		m_FrameCount = std::min(m_FrameCount + 1, (int)m_Frames.size());
+	}
+
+	void RenderStatsHistory::Clear()
+	{
+		for (RenderStats& frame : m_Frames)
+		{
+			frame.Clear();
+		}
+
+		m_Next = 0;
+		m_FrameCount = 0;
+	}
+}
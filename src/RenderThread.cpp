@@ -0,0 +1,246 @@
+// RenderThread.cpp
+
+// SAGE Includes
+#include <SAGE/IRenderDevice.hpp>
+#include <SAGE/Profiler.hpp>
+#include <SAGE/RenderState.hpp>
+#include <SAGE/RenderThread.hpp>
+// SDL Includes
+#include <SDL2/SDL.h>
+
+namespace SAGE
+{
+	RenderThread::RenderThread()
+	{
+		m_Window = nullptr;
+		m_RecordContext = nullptr;
+		m_WriteIndex = 0;
+		m_Running = false;
+		m_Rendering = false;
+		m_PendingPacket = nullptr;
+	}
+
+	RenderThread::~RenderThread()
+	{
+		Stop();
+	}
+
+	bool RenderThread::IsRunning() const
+	{
+		return m_Thread.joinable();
+	}
+
+	const RenderStats& RenderThread::GetCompletedStats() const
+	{
+		return m_CompletedStats;
+	}
+
+	bool RenderThread::Start(Window* p_Window, const SpriteBatchOptions& p_Options)
+	{
+		if (m_Thread.joinable())
+		{
+			SDL_Log("[RenderThread::Start] The render thread is already running.");
+			return false;
+		}
+
+		if (p_Window == nullptr || p_Window->GetContext() == nullptr)
+		{
+			SDL_Log("[RenderThread::Start] The window must be initialized first.");
+			return false;
+		}
+
+		// Vertex arrays aren't shared between contexts, so the replaying batches are created in the window's.
+		if (!m_SpriteBatch.Initialize(p_Options))
+			return false;
+
+		if (!m_GeometryBatch.Initialize())
+			return false;
+
+		// Creating the context makes it current here, which frees the window's context for the render thread.
+		SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+		m_RecordContext = SDL_GL_CreateContext(p_Window->GetC());
+		SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+
+		if (m_RecordContext == nullptr)
+		{
+			SDL_Log("[RenderThread::Start] Failed to create the shared OpenGL context: %s", SDL_GetError());
+			m_SpriteBatch.Finalize();
+			m_GeometryBatch.Finalize();
+			return false;
+		}
+
+		RenderState::Reset();
+
+		m_Window = p_Window;
+		m_WriteIndex = 0;
+		m_Running = true;
+		m_Rendering = false;
+		m_PendingPacket = nullptr;
+		m_RenderedStats.Clear();
+		m_CompletedStats.Clear();
+
+		m_Thread = std::thread(&RenderThread::RenderMain, this);
+
+		return true;
+	}
+
+	bool RenderThread::Stop()
+	{
+		if (!m_Thread.joinable())
+			return true;
+
+		// The render thread finishes any packet already handed over before exiting.
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Running = false;
+		}
+		m_Condition.notify_all();
+
+		m_Thread.join();
+
+		// Take the window's context back so everything else is finalized where it was created.
+		SDL_GL_MakeCurrent(m_Window->GetC(), m_Window->GetContext());
+		SDL_GL_DeleteContext(m_RecordContext);
+		m_RecordContext = nullptr;
+
+		RenderState::Reset();
+
+		for (FramePacket& packet : m_Packets)
+		{
+			if (packet.GetUploadFence() != nullptr)
+				IRenderDevice::Get().DeleteSync(packet.GetUploadFence());
+
+			packet.Clear();
+		}
+
+		m_SpriteBatch.Finalize();
+		m_GeometryBatch.Finalize();
+
+		return true;
+	}
+
+	FramePacket& RenderThread::AcquirePacket()
+	{
+		// SubmitPacket waited for the render thread to finish with this packet before flipping to it.
+		FramePacket& packet = m_Packets[m_WriteIndex];
+		packet.Clear();
+
+		return packet;
+	}
+
+	void RenderThread::SubmitPacket()
+	{
+		if (!m_Thread.joinable())
+		{
+			SDL_Log("[RenderThread::SubmitPacket] The render thread is not running.");
+			return;
+		}
+
+		// Uploads made while recording must be complete before the render thread samples them.
+		FramePacket& packet = m_Packets[m_WriteIndex];
+		packet.SetUploadFence(IRenderDevice::Get().FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+		IRenderDevice::Get().Flush();
+
+		{
+			SAGE_PROFILE_ZONE("RenderThread::SubmitPacket");
+
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Condition.wait(lock, [this]()
+			{
+				return m_PendingPacket == nullptr && !m_Rendering;
+			});
+
+			m_CompletedStats = m_RenderedStats;
+			m_PendingPacket = &packet;
+		}
+		m_Condition.notify_all();
+
+		m_WriteIndex = 1 - m_WriteIndex;
+	}
+
+	void RenderThread::RenderMain()
+	{
+		SAGE_PROFILE_THREAD("Render");
+
+		SDL_GL_MakeCurrent(m_Window->GetC(), m_Window->GetContext());
+		RenderState::Reset();
+
+		while (true)
+		{
+			FramePacket* packet = nullptr;
+
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_Condition.wait(lock, [this]()
+				{
+					return m_PendingPacket != nullptr || !m_Running;
+				});
+
+				if (m_PendingPacket == nullptr)
+					break;
+
+				packet = m_PendingPacket;
+				m_PendingPacket = nullptr;
+				m_Rendering = true;
+			}
+
+			RenderPacket(*packet);
+
+			RenderStats stats = m_SpriteBatch.GetStats();
+			stats += m_GeometryBatch.GetStats();
+
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Rendering = false;
+				m_RenderedStats = stats;
+			}
+			m_Condition.notify_all();
+		}
+
+		SDL_GL_MakeCurrent(m_Window->GetC(), nullptr);
+	}
+
+	void RenderThread::RenderPacket(FramePacket& p_Packet)
+	{
+		SAGE_PROFILE_ZONE("RenderThread::RenderPacket");
+
+		if (p_Packet.GetUploadFence() != nullptr)
+		{
+			IRenderDevice::Get().ClientWaitSync(p_Packet.GetUploadFence(), 0, UploadWaitNanoseconds);
+			IRenderDevice::Get().DeleteSync(p_Packet.GetUploadFence());
+			p_Packet.SetUploadFence(nullptr);
+		}
+
+		m_SpriteBatch.ResetStats();
+		m_GeometryBatch.ResetStats();
+
+		m_Window->Clear();
+
+		// Game renders every sprite pass before any geometry pass, so the replay keeps that order.
+		for (int i = 0; i < p_Packet.GetSpritePassCount(); ++i)
+		{
+			const SpritePass& pass = p_Packet.GetSpritePass(i);
+
+			m_SpriteBatch.Begin(*pass.PassEffect, pass.Camera, pass.Sorting, pass.Blending, pass.Rasterizer);
+			m_SpriteBatch.Submit(pass.Recorder);
+			m_SpriteBatch.Submit(pass.Submitted);
+			m_SpriteBatch.End();
+		}
+
+		m_SpriteBatch.EndFrame();
+
+		for (int i = 0; i < p_Packet.GetGeometryPassCount(); ++i)
+		{
+			const GeometryPass& pass = p_Packet.GetGeometryPass(i);
+
+			m_GeometryBatch.Begin(*pass.PassEffect, pass.Camera);
+			m_GeometryBatch.DrawLineList(pass.Vertices.data(), (int)pass.Vertices.size());
+			m_GeometryBatch.End();
+		}
+
+		{
+			SAGE_PROFILE_ZONE("Window::Flip");
+			m_Window->Flip();
+		}
+	}
+}
@@ -1,6 +1,8 @@
 // Screen.cpp
 
 // SAGE Includes
+#include <SAGE/Game.hpp>
+#include <SAGE/Math.hpp>
 #include <SAGE/Screen.hpp>
 
 namespace SAGE
@@ -11,6 +13,7 @@ namespace SAGE
 		m_TransitionState = TransitionState::On;
 		m_IsActive = true;
 		m_IsVisible = true;
+		m_LoadProgress = 0.0f;
 	}
 
 	Screen::~Screen()
@@ -28,6 +31,11 @@ namespace SAGE
 		return m_IsVisible;
 	}
 
+	float Screen::GetLoadProgress() const
+	{
+		return m_LoadProgress.load();
+	}
+
 	void Screen::SetActive(bool p_Active)
 	{
 		m_IsActive = p_Active;
@@ -38,6 +46,26 @@ namespace SAGE
 		m_IsVisible = p_Visible;
 	}
 
+	JobSystem* Screen::GetJobSystem() const
+	{
+		return m_Manager->GetGame()->GetJobSystem();
+	}
+
+	void Screen::QueueUpload(const ScreenUpload& p_Upload)
+	{
+		m_Uploads.push_back(p_Upload);
+	}
+
+	void Screen::SetLoadProgress(float p_Progress)
+	{
+		m_LoadProgress = Math::Clamp(p_Progress, 0.0f, 1.0f);
+	}
+
+	int Screen::Load()
+	{
+		return 0;
+	}
+
 	int Screen::Initialize()
 	{
 		return 0;
@@ -1,6 +1,8 @@
 // ScreenManager.cpp
 
 // SAGE Includes
+#include <SAGE/Game.hpp>
+#include <SAGE/Profiler.hpp>
 #include <SAGE/ScreenManager.hpp>
 
 namespace SAGE
@@ -10,11 +12,19 @@ namespace SAGE
 		m_ScreenToPush = nullptr;
 		m_PushPause = true;
 		m_PushHide = true;
+		m_PushBackground = false;
 		m_PopCount = 0;
+		m_Loading = false;
+		m_LoadResult = 0;
+		m_UploadIndex = 0;
+		m_UploadNanoseconds = DefaultUploadNanoseconds;
 	}
 
 	ScreenManager::~ScreenManager()
 	{
+		// A worker may still be inside the pending screen's Load.
+		CancelLoading();
+
 		for (int i = (int)m_Screens.size() - 1; i >= 0; --i)
 		{
 			m_Screens[i]->Finalize();
@@ -37,7 +47,37 @@ namespace SAGE
 		return m_Screens.size() == 0 && m_ScreenToPush == nullptr;
 	}
 
-	int ScreenManager::Push(Screen* p_Screen, bool p_Pause, bool p_Hide)
+	bool ScreenManager::IsLoading() const
+	{
+		return m_Loading;
+	}
+
+	float ScreenManager::GetLoadProgress() const
+	{
+		if (!m_Loading)
+			return m_ScreenToPush == nullptr ? 1.0f : 0.0f;
+
+		if (!m_LoadCounter.IsDone())
+			return m_ScreenToPush->GetLoadProgress() * 0.5f;
+
+		int uploadCount = (int)m_ScreenToPush->m_Uploads.size();
+		if (uploadCount == 0)
+			return 1.0f;
+
+		return 0.5f + 0.5f * m_UploadIndex / (float)uploadCount;
+	}
+
+	Uint64 ScreenManager::GetUploadNanoseconds() const
+	{
+		return m_UploadNanoseconds;
+	}
+
+	void ScreenManager::SetUploadNanoseconds(Uint64 p_Nanoseconds)
+	{
+		m_UploadNanoseconds = p_Nanoseconds;
+	}
+
+	int ScreenManager::Push(Screen* p_Screen, bool p_Pause, bool p_Hide, bool p_Background)
 	{
 		if (m_ScreenToPush != nullptr)
 		{
@@ -47,6 +87,7 @@ namespace SAGE
 		m_ScreenToPush = p_Screen;
 		m_PushPause = p_Pause;
 		m_PushHide = p_Hide;
+		m_PushBackground = p_Background;
 
 		return 0;
 	}
@@ -67,6 +108,8 @@ namespace SAGE
 
 	int ScreenManager::Update(float p_DeltaTime)
 	{
+		SAGE_PROFILE_ZONE("ScreenManager::Update");
+
 		// Pop requested screens.
 		while (m_PopCount > 0 && (int)m_Screens.size() != 0)
 		{
@@ -94,8 +137,17 @@ namespace SAGE
 			m_Screens.back()->SetVisible(true);
 		}
 
+		// Background pushes wait here until loaded; the stack keeps running meanwhile.
+		int loadState = 1;
+		if (m_ScreenToPush != nullptr && m_PushBackground)
+		{
+			loadState = ContinueLoading();
+			if (loadState < 0)
+				return -1;
+		}
+
 		// Push new screen.
-		if (m_ScreenToPush != nullptr)
+		if (m_ScreenToPush != nullptr && loadState > 0)
 		{
 			// Alter previous top of stack.
 			if (m_Screens.size() > 0)
@@ -118,6 +170,7 @@ namespace SAGE
 				m_ScreenToPush->Finalize();
 
 				delete m_ScreenToPush;
+				m_ScreenToPush = nullptr;
 
 				return -1;
 			}
@@ -142,8 +195,84 @@ namespace SAGE
 		return 0;
 	}
 
+	int ScreenManager::ContinueLoading()
+	{
+		SAGE_PROFILE_ZONE("ScreenManager::ContinueLoading");
+
+		JobSystem* jobSystem = GetGame()->GetJobSystem();
+
+		if (!m_Loading)
+		{
+			m_Loading = true;
+			m_LoadResult = 0;
+			m_UploadIndex = 0;
+			m_ScreenToPush->m_Uploads.clear();
+			m_ScreenToPush->SetLoadProgress(0.0f);
+
+			// The counter orders the worker's writes before our reads once it reaches zero.
+			Screen* screen = m_ScreenToPush;
+			int* result = &m_LoadResult;
+			jobSystem->ScheduleBackground([screen, result]()
+			{
+				SAGE_PROFILE_ZONE("Screen::Load");
+				*result = screen->Load();
+			}, &m_LoadCounter);
+		}
+
+		if (!m_LoadCounter.IsDone())
+			return 0;
+
+		// Run uploads until the time slice is used up, always making some progress.
+		std::vector<ScreenUpload>& uploads = m_ScreenToPush->m_Uploads;
+		Uint64 start = SDL_GetPerformanceCounter();
+		Uint64 budget = m_UploadNanoseconds * SDL_GetPerformanceFrequency() / 1000000000;
+
+		while (m_LoadResult >= 0 && m_UploadIndex < (int)uploads.size())
+		{
+			if (!uploads[m_UploadIndex]())
+				m_LoadResult = -1;
+
+			m_UploadIndex++;
+
+			if (SDL_GetPerformanceCounter() - start >= budget)
+				break;
+		}
+
+		if (m_LoadResult < 0)
+		{
+			SDL_Log("[ScreenManager::ContinueLoading] The screen failed to load.");
+			CancelLoading();
+			return -1;
+		}
+
+		if (m_UploadIndex < (int)uploads.size())
+			return 0;
+
+		uploads.clear();
+		uploads.shrink_to_fit();
+		m_Loading = false;
+
+		return 1;
+	}
+
+	void ScreenManager::CancelLoading()
+	{
+		if (!m_Loading)
+			return;
+
+		GetGame()->GetJobSystem()->Wait(m_LoadCounter);
+
+		m_ScreenToPush->Finalize();
+
+		delete m_ScreenToPush;
+		m_ScreenToPush = nullptr;
+		m_Loading = false;
+	}
+
 	int ScreenManager::Render(SpriteBatch& p_SpriteBatch)
 	{
+		SAGE_PROFILE_ZONE("ScreenManager::Render(SpriteBatch)");
+
 		// Render
 		for (int i = 0; i < (int)m_Screens.size(); ++i)
 		{
@@ -159,6 +288,8 @@ namespace SAGE
 
 	int ScreenManager::Render(GeometryBatch& p_GeometryBatch)
 	{
+		SAGE_PROFILE_ZONE("ScreenManager::Render(GeometryBatch)");
+
 		// Render
 		for (int i = 0; i < (int)m_Screens.size(); ++i)
 		{
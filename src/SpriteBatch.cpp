@@ -3,19 +3,64 @@
 // OpenGL Includes
 #include <GL/glew.h>
 // SAGE Includes
+#include <SAGE/FramePacket.hpp>
+#include <SAGE/IRenderDevice.hpp>
 #include <SAGE/Math.hpp>
+#include <SAGE/Profiler.hpp>
+#include <SAGE/RenderState.hpp>
 #include <SAGE/SpriteBatch.hpp>
-#include <SAGE/String.hpp>
 // STL Includes
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
 
 namespace SAGE
 {
+	const BufferMode SpriteBatchOptions::DefaultBufferMode = BufferMode::PersistentRing;
+	const VertexFormat SpriteBatchOptions::DefaultVertexFormat = VertexFormat::Full;
+	const bool SpriteBatchOptions::DefaultInstancing = false;
+	const int SpriteBatchOptions::DefaultTextureSlots = 1;
+	const bool SpriteBatchOptions::DefaultCulling = false;
+	const bool SpriteBatchOptions::DefaultTextCaching = false;
+
+	const SpriteBatchOptions SpriteBatchOptions::DefaultOptions;
+
 	SpriteBatch::SpriteBatch()
 	{
 		m_WithinDrawPair = false;
-		m_ItemCount = 0;
 		m_FlushCount = 0;
+		m_VertexArrayObject = 0;
+		m_VertexBufferObject = 0;
+		m_IndexBufferObject = 0;
+		m_BufferMode = BufferMode::Dynamic;
+		m_VertexFormat = VertexFormat::Full;
+		m_VertexStride = sizeof(VertexPositionColorTexture);
+		m_TextureSlots = 1;
+		m_RunTextureSlots = 1;
+		m_MappedVertices = nullptr;
+		m_SectionIndex = 0;
+		m_SectionOffset = 0;
+		m_RangeBaseVertex = 0;
+		m_Instancing = false;
+		m_UsingInstanceEffect = false;
+		m_InstanceArrayObject = 0;
+		m_InstanceBufferObject = 0;
+		m_Effect = nullptr;
+		m_IsSorted = false;
+		m_RenderRecorder = nullptr;
+		m_RenderCount = 0;
+		m_Culling = false;
+		m_TextCaching = false;
+		m_SubmittedCount = 0;
+		m_CulledCount = 0;
+		m_UploadedByteCount = 0;
+		m_Capture = nullptr;
+		m_CapturePass = nullptr;
+
+		for (int i = 0; i < RingSectionCount; ++i)
+		{
+			m_SectionFences[i] = nullptr;
+		}
 	}
 
 	SpriteBatch::~SpriteBatch()
@@ -28,67 +73,288 @@ namespace SAGE
 		return m_FlushCount;
 	}
 
-	bool SpriteBatch::Initialize()
+	BufferMode SpriteBatch::GetBufferMode() const
+	{
+		return m_BufferMode;
+	}
+
+	VertexFormat SpriteBatch::GetVertexFormat() const
+	{
+		return m_VertexFormat;
+	}
+
+	bool SpriteBatch::IsInstancing() const
+	{
+		return m_Instancing;
+	}
+
+	int SpriteBatch::GetTextureSlots() const
+	{
+		return m_TextureSlots;
+	}
+
+	bool SpriteBatch::IsCulling() const
+	{
+		return m_Culling;
+	}
+
+	bool SpriteBatch::IsTextCaching() const
+	{
+		return m_TextCaching;
+	}
+
+	int SpriteBatch::GetSubmittedCount() const
+	{
+		return m_SubmittedCount;
+	}
+
+	int SpriteBatch::GetCulledCount() const
+	{
+		return m_CulledCount;
+	}
+
+	int SpriteBatch::GetUploadedByteCount() const
+	{
+		return m_UploadedByteCount;
+	}
+
+	const RenderStats& SpriteBatch::GetStats() const
+	{
+		return m_Stats;
+	}
+
+	void SpriteBatch::ResetStats()
+	{
+		m_Stats.Clear();
+	}
+
+	void SpriteBatch::EndFrame()
+	{
+		if (m_WithinDrawPair)
+		{
+			SDL_Log("[SpriteBatch::EndFrame] Cannot end a frame within a draw pair.");
+			return;
+		}
+
+		m_Recorder.EndFrame();
+
+		// Frames that drew nothing keep their section.
+		if (m_BufferMode == BufferMode::PersistentRing && m_SectionOffset > 0)
+			AdvanceVertexSection();
+	}
+
+	bool SpriteBatch::IsCapturing() const
+	{
+		return m_Capture != nullptr;
+	}
+
+	bool SpriteBatch::SetCapture(FramePacket* p_Packet)
+	{
+		if (m_WithinDrawPair)
+		{
+			SDL_Log("[SpriteBatch::SetCapture] Cannot change capture within a draw pair.");
+			return false;
+		}
+
+		m_Capture = p_Packet;
+
+		return true;
+	}
+
+	bool SpriteBatch::SetCulling(bool p_Culling)
+	{
+		if (m_WithinDrawPair)
+		{
+			SDL_Log("[SpriteBatch::SetCulling] Cannot change culling within a draw pair.");
+			return false;
+		}
+
+		m_Culling = p_Culling;
+
+		return true;
+	}
+
+	bool SpriteBatch::SetTextCaching(bool p_TextCaching)
+	{
+		if (m_WithinDrawPair)
+		{
+			SDL_Log("[SpriteBatch::SetTextCaching] Cannot change text caching within a draw pair.");
+			return false;
+		}
+
+		m_TextCaching = p_TextCaching;
+		m_Recorder.SetTextCaching(m_TextCaching);
+
+		return true;
+	}
+
+	bool SpriteBatch::Initialize(const SpriteBatchOptions& p_Options)
 	{
 		// Collect type sizes.
 		GLsizei sizeUShort = sizeof(GLushort);
 		GLsizei sizeFloat = sizeof(GLfloat);
-		GLsizei sizeVPCT = sizeof(VertexPositionColorTexture);
 
-		// Enable GLew.
-		glewExperimental = GL_TRUE;
-		GLenum res = glewInit();
-		if (res != GLEW_OK)
+		// Prepare the render device.
+		if (!IRenderDevice::Get().Initialize())
 		{
-			SDL_Log("[SpriteBatch::Initialize] GLEW failed to initialize: %s", glewGetErrorString(res));
+			SDL_Log("[SpriteBatch::Initialize] The render device failed to initialize.");
 			return false;
 		}
 
-		// Generate data for index buffer.
-		GLushort indexData[MaxIndexCount];
-		for (int i = 0; i < MaxIndexCount / 3; ++i)
+		// Select the vertex layout uploaded to the GPU.
+		m_VertexFormat = p_Options.Format;
+		switch (m_VertexFormat)
 		{
-			for (int j = 0; j < 3; ++j)
-			{
-				indexData[i * 3 + j] = i * 3 + j;
-			}
+			case VertexFormat::Full:
+				m_VertexStride = sizeof(VertexPositionColorTexture);
+				break;
+			case VertexFormat::Packed:
+				m_VertexStride = sizeof(VertexPositionColorTexturePacked);
+				break;
 		}
 
-		// Create the index buffer object.
-		m_IndexBufferObject = -1;
-		glGenBuffers(1, &m_IndexBufferObject);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferObject);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, MaxIndexCount * sizeUShort, indexData, GL_STATIC_DRAW);
+		// Several textures per draw need a texture slot after each vertex.
+		m_TextureSlots = Math::Clamp(p_Options.TextureSlots, 1, static_cast<int>(Effect::MaxTextureSlots));
+		GLsizei slotOffset = m_VertexStride;
+		if (m_TextureSlots > 1)
+		{
+			m_VertexStride += sizeof(GLuint);
+		}
+
+		// Persistent mapping requires buffer storage (GL 4.4 or ARB_buffer_storage).
+		m_BufferMode = p_Options.Buffering;
+		if (m_BufferMode == BufferMode::PersistentRing && !IRenderDevice::Get().SupportsBufferStorage())
+		{
+			SDL_Log("[SpriteBatch::Initialize] Buffer storage is unsupported. Falling back to dynamic vertex uploads.");
+			m_BufferMode = BufferMode::Dynamic;
+		}
+
+		// Generate data for index buffer. Each quad is drawn as 0-1-2 / 2-1-3.
+		GLushort indexData[MaxIndexCount];
+		for (int i = 0; i < MaxIndexCount / 6; ++i)
+		{
+			indexData[i * 6 + 0] = i * 4 + 0;
+			indexData[i * 6 + 1] = i * 4 + 1;
+			indexData[i * 6 + 2] = i * 4 + 2;
+			indexData[i * 6 + 3] = i * 4 + 2;
+			indexData[i * 6 + 4] = i * 4 + 1;
+			indexData[i * 6 + 5] = i * 4 + 3;
+		}
 
 		// Create the vertex array object.
 		m_VertexArrayObject = -1;
-		glGenVertexArrays(1, &m_VertexArrayObject);
-		glBindVertexArray(m_VertexArrayObject);
+		IRenderDevice::Get().GenVertexArrays(1, &m_VertexArrayObject);
+		RenderState::BindVertexArray(m_VertexArrayObject);
+
+		// Create the index buffer object. Binding it while the vertex array is bound keeps it there for every draw.
+		m_IndexBufferObject = -1;
+		IRenderDevice::Get().GenBuffers(1, &m_IndexBufferObject);
+		RenderState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferObject);
+		IRenderDevice::Get().BufferData(GL_ELEMENT_ARRAY_BUFFER, MaxIndexCount * sizeUShort, indexData, GL_STATIC_DRAW);
 
 		// Create the vertex buffer object.
 		m_VertexBufferObject = -1;
-		glGenBuffers(1, &m_VertexBufferObject);
-		glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
-		glBufferData(GL_ARRAY_BUFFER, MaxVertexCount * sizeVPCT, nullptr, GL_DYNAMIC_DRAW);
+		IRenderDevice::Get().GenBuffers(1, &m_VertexBufferObject);
+		RenderState::BindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
+
+		if (m_BufferMode == BufferMode::PersistentRing)
+		{
+			// Allocate one section per frame in flight and keep it mapped for the batch's lifetime.
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			GLsizeiptr size = RingSectionCount * MaxVertexCount * m_VertexStride;
+
+			IRenderDevice::Get().BufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+			m_MappedVertices = static_cast<unsigned char*>(IRenderDevice::Get().MapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+			if (m_MappedVertices == nullptr)
+			{
+				SDL_Log("[SpriteBatch::Initialize] Failed to map the vertex ring buffer.");
+				return false;
+			}
+
+			m_SectionIndex = 0;
+			m_SectionOffset = 0;
+		}
+		else
+		{
+			IRenderDevice::Get().BufferData(GL_ARRAY_BUFFER, MaxVertexCount * m_VertexStride, nullptr, GL_DYNAMIC_DRAW);
+
+			// Vertices are staged on the client before each upload.
+			m_VertexBuffer.resize(MaxVertexCount * m_VertexStride);
+		}
 
 		#define BUFFER_OFFSET(i) ((char*)0 + (i))
 
 		// Position attribute
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeVPCT, BUFFER_OFFSET(sizeFloat * 0));
-		// Color attribute
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeVPCT, BUFFER_OFFSET(sizeFloat * 2));
-		// Texcoord attribute
-		glEnableVertexAttribArray(2);
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeVPCT, BUFFER_OFFSET(sizeFloat * 6));
+		IRenderDevice::Get().EnableVertexAttribArray(0);
+		IRenderDevice::Get().VertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, m_VertexStride, BUFFER_OFFSET(sizeFloat * 0));
+
+		switch (m_VertexFormat)
+		{
+			case VertexFormat::Full:
+				// Color attribute
+				IRenderDevice::Get().EnableVertexAttribArray(1);
+				IRenderDevice::Get().VertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, m_VertexStride, BUFFER_OFFSET(sizeFloat * 2));
+				// Texcoord attribute
+				IRenderDevice::Get().EnableVertexAttribArray(2);
+				IRenderDevice::Get().VertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, m_VertexStride, BUFFER_OFFSET(sizeFloat * 6));
+				break;
+			case VertexFormat::Packed:
+				// Color attribute (normalized RGBA8)
+				IRenderDevice::Get().EnableVertexAttribArray(1);
+				IRenderDevice::Get().VertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, m_VertexStride, BUFFER_OFFSET(sizeFloat * 2));
+				// Texcoord attribute (normalized unsigned 16-bit)
+				IRenderDevice::Get().EnableVertexAttribArray(2);
+				IRenderDevice::Get().VertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, GL_TRUE, m_VertexStride, BUFFER_OFFSET(sizeFloat * 3));
+				break;
+		}
+
+		// Texture slot attribute
+		if (m_TextureSlots > 1)
+		{
+			IRenderDevice::Get().EnableVertexAttribArray(3);
+			IRenderDevice::Get().VertexAttribIPointer(3, 1, GL_UNSIGNED_INT, m_VertexStride, BUFFER_OFFSET(slotOffset));
+		}
 
 		#undef BUFFER_OFFSET
 
 		// Clear bindings.
-		glBindVertexArray(0);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		RenderState::BindVertexArray(0);
+		RenderState::BindBuffer(GL_ARRAY_BUFFER, 0);
+
+		m_Culling = p_Options.Culling;
+		m_TextCaching = p_Options.TextCaching;
+		m_Recorder.SetTextCaching(m_TextCaching);
+
+		// Create the per-instance buffer and the effect that expands instances into quads.
+		m_Instancing = p_Options.Instancing;
+		if (m_Instancing)
+		{
+			GLsizei sizeVSI = sizeof(VertexSpriteInstance);
+
+			m_InstanceBuffer.resize(MaxBatchSize);
+
+			IRenderDevice::Get().GenVertexArrays(1, &m_InstanceArrayObject);
+			RenderState::BindVertexArray(m_InstanceArrayObject);
+
+			IRenderDevice::Get().GenBuffers(1, &m_InstanceBufferObject);
+			RenderState::BindBuffer(GL_ARRAY_BUFFER, m_InstanceBufferObject);
+			IRenderDevice::Get().BufferData(GL_ARRAY_BUFFER, MaxBatchSize * sizeVSI, nullptr, GL_DYNAMIC_DRAW);
+
+			for (GLuint i = 0; i < 7; ++i)
+			{
+				IRenderDevice::Get().EnableVertexAttribArray(i);
+				IRenderDevice::Get().VertexAttribDivisor(i, 1);
+			}
+
+			RenderState::BindVertexArray(0);
+			RenderState::BindBuffer(GL_ARRAY_BUFFER, 0);
+
+			if (!m_InstanceEffect.Create(Effect::BasicType::SpriteInstance))
+			{
+				SDL_Log("[SpriteBatch::Initialize] Failed to create the sprite instancing effect.");
+				return false;
+			}
+		}
 
 		// Create the blank texture.
 		std::vector<Color> colors = { Color::White };
@@ -103,10 +369,61 @@ namespace SAGE
 
 	bool SpriteBatch::Finalize()
 	{
+		// Release the persistent mapping and any outstanding fences.
+		if (m_MappedVertices != nullptr)
+		{
+			RenderState::BindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
+			IRenderDevice::Get().UnmapBuffer(GL_ARRAY_BUFFER);
+
+			m_MappedVertices = nullptr;
+		}
+
+		for (int i = 0; i < RingSectionCount; ++i)
+		{
+			if (m_SectionFences[i] != nullptr)
+			{
+				IRenderDevice::Get().DeleteSync(m_SectionFences[i]);
+				m_SectionFences[i] = nullptr;
+			}
+		}
+
 		// Destroy objects.
-		glDeleteVertexArrays(1, &m_VertexArrayObject);
-		glDeleteBuffers(1, &m_VertexBufferObject);
-		glDeleteBuffers(1, &m_IndexBufferObject);
+		RenderState::ForgetVertexArray(m_VertexArrayObject);
+		RenderState::ForgetVertexArray(m_InstanceArrayObject);
+		RenderState::ForgetBuffer(m_VertexBufferObject);
+		RenderState::ForgetBuffer(m_IndexBufferObject);
+		RenderState::ForgetBuffer(m_InstanceBufferObject);
+
+		IRenderDevice::Get().DeleteVertexArrays(1, &m_VertexArrayObject);
+		IRenderDevice::Get().DeleteBuffers(1, &m_VertexBufferObject);
+		IRenderDevice::Get().DeleteBuffers(1, &m_IndexBufferObject);
+		IRenderDevice::Get().DeleteVertexArrays(1, &m_InstanceArrayObject);
+		IRenderDevice::Get().DeleteBuffers(1, &m_InstanceBufferObject);
+
+		m_VertexArrayObject = 0;
+		m_VertexBufferObject = 0;
+		m_IndexBufferObject = 0;
+		m_InstanceArrayObject = 0;
+		m_InstanceBufferObject = 0;
+
+		m_InstanceEffect.Finalize();
+
+		return true;
+	}
+
+	bool SpriteBatch::Trim()
+	{
+		if (m_WithinDrawPair)
+		{
+			SDL_Log("[SpriteBatch::Trim] Cannot trim storage within a draw pair.");
+			return false;
+		}
+
+		m_Recorder.Trim();
+
+		std::vector<SpriteBatchSortEntry>().swap(m_SortEntries);
+		std::vector<SpriteBatchSortEntry>().swap(m_SortScratch);
+		std::vector<SpriteBatchRun>().swap(m_DrawRuns);
 
 		return true;
 	}
@@ -121,18 +438,43 @@ namespace SAGE
 
 		// Initialize drawing values.
 		m_WithinDrawPair = true;
-		m_ItemCount = 0;
 		m_FlushCount = 0;
+		m_Recorder.Reset(m_BlankTexture.GetID(), m_Instancing);
+		m_SubmittedRecorders.clear();
+		m_SubmittedCount = 0;
+		m_CulledCount = 0;
+		m_UploadedByteCount = 0;
+
+		// Reject anything outside what the camera can see, including its rotation and zoom.
+		if (m_Culling)
+		{
+			p_Camera.GetWorldBounds(m_CullMinimum, m_CullMaximum);
+			m_Recorder.SetCullBounds(m_CullMinimum, m_CullMaximum);
+		}
 
 		// Store parameters.
 		m_SortMode = p_SortMode;
 		m_BlendMode = p_BlendMode;
 		m_RasterizerState = p_RasterizerState;
+		m_Effect = &p_Effect;
+		m_RunTextureSlots = p_Effect.ReadsTextureSlots() ? m_TextureSlots : 1;
+		m_ProjectionMatrix = p_Camera.GetProjectionMatrix();
+		m_ModelViewMatrix = p_Camera.GetModelViewMatrix();
+
+		// Captured pairs are replayed with these parameters later, so GL is left alone.
+		if (m_Capture != nullptr)
+		{
+			m_CapturePass = &m_Capture->AddSpritePass(p_Effect, p_Camera, p_SortMode, p_BlendMode, p_RasterizerState);
+			m_CapturePass->Submitted.Reset(m_BlankTexture.GetID(), m_Instancing);
 
-		// Set matrices from camera.
-		p_Effect.SetProjection(p_Camera.GetProjectionMatrix());
-		p_Effect.SetModelView(p_Camera.GetModelViewMatrix());
-		p_Effect.Use();
+			return true;
+		}
+
+		// Set matrices from camera. Uniforms apply to the bound program, so bind it first.
+		m_Effect->Use();
+		m_Effect->SetProjection(m_ProjectionMatrix);
+		m_Effect->SetModelView(m_ModelViewMatrix);
+		m_UsingInstanceEffect = false;
 
 		return true;
 	}
@@ -150,94 +492,47 @@ namespace SAGE
 			return false;
 		}
 
-		// Create the identity vector perpendicular to the line.
-		Vector2 perpendicular = Vector2(p_PositionA.Y - p_PositionB.Y, p_PositionB.X - p_PositionA.X);
-		perpendicular.Normalize();
-
-		SpriteBatchItem& item1 = GetNextItem(m_BlankTexture, p_Depth);
-		SpriteBatchItem& item2 = GetNextItem(m_BlankTexture, p_Depth);
-
-		// Top left vertex.
-		SetVertex(item1.VertexA,
-			p_PositionA.X + perpendicular.X * p_Thickness / 2.0f, p_PositionA.Y + perpendicular.Y * p_Thickness / 2.0f,
-			p_ColorA,
-			0.0f, 1.0f);
+		bool result = m_Recorder.DrawLine(p_PositionA, p_ColorA, p_PositionB, p_ColorB, p_Thickness, p_Depth);
+		FlushFullRecorder();
 
-		// Top right vertex. (2)
-		SetVertex(item1.VertexC,
-			p_PositionA.X - perpendicular.X * p_Thickness / 2.0f, p_PositionA.Y - perpendicular.Y * p_Thickness / 2.0f,
-			p_ColorA,
-			1.0f, 1.0f);
-
-		SetVertex(item2.VertexA,
-			p_PositionA.X - perpendicular.X * p_Thickness / 2.0f, p_PositionA.Y - perpendicular.Y * p_Thickness / 2.0f,
-			p_ColorA,
-			1.0f, 1.0f);
-
-		// Bottom left vertex. (2)
-		SetVertex(item1.VertexB,
-			p_PositionB.X + perpendicular.X * p_Thickness / 2.0f, p_PositionB.Y + perpendicular.Y * p_Thickness / 2.0f,
-			p_ColorB,
-			0.0f, 0.0f);
-
-		SetVertex(item2.VertexB,
-			p_PositionB.X + perpendicular.X * p_Thickness / 2.0f, p_PositionB.Y + perpendicular.Y * p_Thickness / 2.0f,
-			p_ColorB,
-			0.0f, 0.0f);
-
-		// Bottom right vertex.
-		SetVertex(item2.VertexC,
-			p_PositionB.X - perpendicular.X * p_Thickness / 2.0f, p_PositionB.Y - perpendicular.Y * p_Thickness / 2.0f,
-			p_ColorB,
-			1.0f, 0.0f);
-
-		return true;
+		return result;
 	}
 
 	bool SpriteBatch::DrawLines(const std::vector<Vector2>& p_Positions, const Color& p_Color, float p_Thickness, float p_Depth)
 	{
-		std::vector<Color> colors = { p_Color };
-
-		return DrawLines(p_Positions, colors, p_Thickness, p_Depth);
+		return DrawLines(p_Positions.data(), static_cast<int>(p_Positions.size()), &p_Color, 1, p_Thickness, p_Depth);
 	}
 
 	bool SpriteBatch::DrawLines(const std::vector<Vector2>& p_Positions, const std::vector<Color>& p_Colors, float p_Thickness, float p_Depth)
 	{
-		if (!m_WithinDrawPair)
-		{
-			SDL_Log("[SpriteBatch::DrawLine] Must start a draw pair first.");
-			return false;
-		}
-
-		int positionCount = static_cast<int>(p_Positions.size());
+		return DrawLines(p_Positions.data(), static_cast<int>(p_Positions.size()), p_Colors.data(), static_cast<int>(p_Colors.size()), p_Thickness, p_Depth);
+	}
 
-		if (positionCount < 2)
+	bool SpriteBatch::DrawLines(const Vector2* p_Positions, int p_PositionCount, const Color* p_Colors, int p_ColorCount, float p_Thickness, float p_Depth)
+	{
+		if (!m_WithinDrawPair)
 		{
-			SDL_Log("[SpriteBatch::DrawLine] Position vector must contain at least 2 values.");
+			SDL_Log("[SpriteBatch::DrawLines] Must start a draw pair first.");
 			return false;
 		}
 
-		int colorCount = static_cast<int>(p_Colors.size());
-
-		for (int i = 0; i < positionCount - 1; ++i)
-		{
-			if (!DrawLine(p_Positions[i], p_Colors[i % colorCount], p_Positions[i + 1], p_Colors[(i + 1) % colorCount], p_Thickness, p_Depth))
-			{
-				return false;
-			}
-		}
+		bool result = m_Recorder.DrawLines(p_Positions, p_PositionCount, p_Colors, p_ColorCount, p_Thickness, p_Depth);
+		FlushFullRecorder();
 
-		return true;
+		return result;
 	}
 
 	bool SpriteBatch::DrawLineLoop(const std::vector<Vector2>& p_Positions, const Color& p_Color, float p_Thickness, float p_Depth)
 	{
-		std::vector<Color> colors = { p_Color };
-
-		return DrawLineLoop(p_Positions, colors, p_Thickness, p_Depth);
+		return DrawLineLoop(p_Positions.data(), static_cast<int>(p_Positions.size()), &p_Color, 1, p_Thickness, p_Depth);
 	}
 
 	bool SpriteBatch::DrawLineLoop(const std::vector<Vector2>& p_Positions, const std::vector<Color>& p_Colors, float p_Thickness, float p_Depth)
+	{
+		return DrawLineLoop(p_Positions.data(), static_cast<int>(p_Positions.size()), p_Colors.data(), static_cast<int>(p_Colors.size()), p_Thickness, p_Depth);
+	}
+
+	bool SpriteBatch::DrawLineLoop(const Vector2* p_Positions, int p_PositionCount, const Color* p_Colors, int p_ColorCount, float p_Thickness, float p_Depth)
 	{
 		if (!m_WithinDrawPair)
 		{
@@ -245,37 +540,23 @@ namespace SAGE
 			return false;
 		}
 
-		int positionCount = static_cast<int>(p_Positions.size());
+		bool result = m_Recorder.DrawLineLoop(p_Positions, p_PositionCount, p_Colors, p_ColorCount, p_Thickness, p_Depth);
+		FlushFullRecorder();
 
-		if (positionCount < 3)
-		{
-			SDL_Log("[SpriteBatch::DrawLineLoop] Position vector must contain at least 3 values.");
-			return false;
-		}
-
-		int colorCount = static_cast<int>(p_Colors.size());
-
-		for (int i = 0; i < positionCount; ++i)
-		{
-			if (!DrawLine(p_Positions[i % positionCount], p_Colors[i % colorCount],
-						  p_Positions[(i + 1) % positionCount], p_Colors[(i + 1) % colorCount],
-						  p_Thickness, p_Depth))
-			{
-				return false;
-			}
-		}
-
-		return true;
+		return result;
 	}
 
-	bool SpriteBatch::DrawCircle(const Vector2& p_Position, const Color& p_Color, float p_Radius, float p_Thickness, float p_Depth)
+	bool SpriteBatch::DrawCircle(const Vector2& p_Position, const Color& p_Color, float p_Radius, float p_Thickness, float p_Depth, const UnitCircle& p_Circle)
 	{
-		std::vector<Color> colors = { p_Color };
-
-		return DrawCircle(p_Position, colors, p_Radius, p_Thickness, p_Depth);
+		return DrawCircle(p_Position, &p_Color, 1, p_Radius, p_Thickness, p_Depth, p_Circle);
 	}
 
 	bool SpriteBatch::DrawCircle(const Vector2& p_Position, const std::vector<Color>& p_Colors, float p_Radius, float p_Thickness, float p_Depth)
+	{
+		return DrawCircle(p_Position, p_Colors.data(), static_cast<int>(p_Colors.size()), p_Radius, p_Thickness, p_Depth);
+	}
+
+	bool SpriteBatch::DrawCircle(const Vector2& p_Position, const Color* p_Colors, int p_ColorCount, float p_Radius, float p_Thickness, float p_Depth, const UnitCircle& p_Circle)
 	{
 		if (!m_WithinDrawPair)
 		{
@@ -283,17 +564,10 @@ namespace SAGE
 			return false;
 		}
 
-		std::vector<Vector2> positions;
-		for (float angle = 0.0f; angle < Math::TwoPi; angle += Math::Pi / 16.0f)
-		{
-			float cosAngle = cosf(angle);
-			float sinAngle = sinf(angle);
-
-			positions.push_back(Vector2(p_Position.X + p_Radius * cosAngle,
-										p_Position.Y + p_Radius * sinAngle));
-		}
+		bool result = m_Recorder.DrawCircle(p_Position, p_Colors, p_ColorCount, p_Radius, p_Thickness, p_Depth, p_Circle);
+		FlushFullRecorder();
 
-		return DrawLineLoop(positions, p_Colors, p_Thickness, p_Depth);
+		return result;
 	}
 
 	bool SpriteBatch::DrawSolidTriangle(const Vector2 p_Positions[3], const Color& p_Color, float p_Depth)
@@ -304,7 +578,7 @@ namespace SAGE
 
 		return DrawSolidTriangle(p_Positions, colors, p_Depth);
 	}
-	
+
 	bool SpriteBatch::DrawSolidTriangle(const Vector2 p_Positions[3], const Color p_Colors[3], float p_Depth)
 	{
 		if (!m_WithinDrawPair)
@@ -313,27 +587,10 @@ namespace SAGE
 			return false;
 		}
 
-		SpriteBatchItem& item = GetNextItem(m_BlankTexture, p_Depth);
-
-		// Top left vertex.
-		SetVertex(item.VertexA,
-			p_Positions[0].X, p_Positions[0].Y,
-			p_Colors[0],
-			0.0f, 0.0f);
-
-		// Top right vertex.
-		SetVertex(item.VertexB,
-			p_Positions[1].X, p_Positions[1].Y,
-			p_Colors[1],
-			0.0f, 0.0f);
-
-		// Bottom left vertex.
-		SetVertex(item.VertexC,
-			p_Positions[2].X, p_Positions[2].Y,
-			p_Colors[2],
-			0.0f, 0.0f);
+		bool result = m_Recorder.DrawSolidTriangle(p_Positions, p_Colors, p_Depth);
+		FlushFullRecorder();
 
-		return true;
+		return result;
 	}
 
 	bool SpriteBatch::DrawSolidRectangle(float p_X, float p_Y, float p_Width, float p_Height, const Color& p_Color, float p_Depth)
@@ -344,44 +601,10 @@ namespace SAGE
 			return false;
 		}
 
-		SpriteBatchItem& item1 = GetNextItem(m_BlankTexture, p_Depth);
-		SpriteBatchItem& item2 = GetNextItem(m_BlankTexture, p_Depth);
-
-		// Top left vertex.
-		SetVertex(item1.VertexA,
-			p_X, p_Y,
-			p_Color,
-			0.0f, 1.0f);
-
-		// Top right vertex. (2)
-		SetVertex(item1.VertexC,
-			p_X + p_Width, p_Y,
-			p_Color,
-			1.0f, 1.0f);
-
-		SetVertex(item2.VertexA,
-			p_X + p_Width, p_Y,
-			p_Color,
-			1.0f, 1.0f);
-
-		// Bottom left vertex. (2)
-		SetVertex(item1.VertexB,
-			p_X, p_Y + p_Height,
-			p_Color,
-			0.0f, 0.0f);
-
-		SetVertex(item2.VertexB,
-			p_X, p_Y + p_Height,
-			p_Color,
-			0.0f, 0.0f);
-
-		// Bottom right vertex.
-		SetVertex(item2.VertexC,
-			p_X + p_Width, p_Y + p_Height,
-			p_Color,
-			1.0f, 0.0f);
+		bool result = m_Recorder.DrawSolidRectangle(p_X, p_Y, p_Width, p_Height, p_Color, p_Depth);
+		FlushFullRecorder();
 
-		return true;
+		return result;
 	}
 
 	bool SpriteBatch::DrawSolidRectangle(const Rectangle& p_Rectangle, const Color& p_Color, float p_Depth)
@@ -398,12 +621,12 @@ namespace SAGE
 		return DrawSolidRectangle(p_Position.X, p_Position.Y, p_Dimensions.X, p_Dimensions.Y, p_Color, p_Depth);
 	}
 
-	bool SpriteBatch::DrawSolidCircle(const Vector2& p_Position, const Color& p_Color, float p_Radius, float p_Depth)
+	bool SpriteBatch::DrawSolidCircle(const Vector2& p_Position, const Color& p_Color, float p_Radius, float p_Depth, const UnitCircle& p_Circle)
 	{
-		return DrawSolidCircle(p_Position, p_Color, p_Color, p_Radius, p_Depth);
+		return DrawSolidCircle(p_Position, p_Color, p_Color, p_Radius, p_Depth, p_Circle);
 	}
 
-	bool SpriteBatch::DrawSolidCircle(const Vector2& p_Position, const Color& p_ColorA, const Color& p_ColorB, float p_Radius, float p_Depth)
+	bool SpriteBatch::DrawSolidCircle(const Vector2& p_Position, const Color& p_ColorA, const Color& p_ColorB, float p_Radius, float p_Depth, const UnitCircle& p_Circle)
 	{
 		if (!m_WithinDrawPair)
 		{
@@ -411,39 +634,10 @@ namespace SAGE
 			return false;
 		}
 
-		Vector2 positions[3];
-		positions[1] = p_Position;
-
-		Color colors[3] = {
-			p_ColorB,
-			p_ColorA,
-			p_ColorB
-		};
-
-		float step = Math::Pi / 16.0f;
-		for (float angle = 0.0f; angle < Math::TwoPi; angle += step)
-		{
-			float cosAngleA = cosf(angle);
-			float sinAngleA = sinf(angle);
-			float cosAngleB = cosf(angle + step);
-			float sinAngleB = sinf(angle + step);
-
-			positions[0].X = p_Position.X + p_Radius * cosAngleA;
-			positions[0].Y = p_Position.Y + p_Radius * sinAngleA;
+		bool result = m_Recorder.DrawSolidCircle(p_Position, p_ColorA, p_ColorB, p_Radius, p_Depth, p_Circle);
+		FlushFullRecorder();
 
-			positions[2].X = p_Position.X + p_Radius * cosAngleB;
-			positions[2].Y = p_Position.Y + p_Radius * sinAngleB;
-/*
-			SDL_Log("Angle: %f, { %f, %f }, { %f, %f }, { %f, %f }",
-				angle,
-				positions[0].X, positions[0].Y,
-				positions[1].X, positions[1].Y,
-				positions[2].X, positions[2].Y);
-*/
-			DrawSolidTriangle(positions, colors, p_Depth);
-		}
-
-		return true;
+		return result;
 	}
 
 	bool SpriteBatch::DrawSprite(const Texture& p_Texture, const Vector2& p_Position, const Vector2& p_Dimensions, const Rectangle& p_SourceRectangle, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth)
@@ -472,83 +666,24 @@ namespace SAGE
 			return false;
 		}
 
-		float textureWidth = static_cast<float>(p_Texture.GetWidth());
-		float textureHeight = static_cast<float>(p_Texture.GetHeight());
+		bool result = m_Recorder.DrawSprite(p_Texture, p_Position, p_SourceRectangle, p_Color, p_Origin, p_Rotation, p_Scale, p_Orientation, p_Depth);
+		FlushFullRecorder();
 
-		float correctionX = 1.0f / textureWidth;
-		float correctionY = 1.0f / textureHeight;
+		return result;
+	}
 
-		Rectangle textureBounds;
-		if (p_SourceRectangle != Rectangle::Empty)
-			textureBounds = p_SourceRectangle;
-		else
-			textureBounds = Rectangle(0, 0, textureWidth, textureHeight);
-
-		float sizeX = textureBounds.Width * p_Scale.X;
-		float sizeY = textureBounds.Height * p_Scale.Y;
-
-		float originX = -p_Origin.X * p_Scale.X;
-		float originY = -p_Origin.Y * p_Scale.Y;
-
-		float texCoordTop = textureBounds.Y / textureHeight + correctionY;
-		float texCoordBottom = (textureBounds.Y + textureBounds.Height) / textureHeight - correctionY;
-		float texCoordLeft = textureBounds.X / textureWidth + correctionX;
-		float texCoordRight = (textureBounds.X + textureBounds.Width) / textureWidth - correctionX;
-
-		// Calculate cos/sin for rotation in radians.
-		float cosAngle = cosf(p_Rotation);
-		float sinAngle = sinf(p_Rotation);
-
-		// Flip texture coordinates for orientation.
-		if ((p_Orientation & Orientation::FlipHorizontal) == Orientation::FlipHorizontal)
-			std::swap(texCoordLeft, texCoordRight);
-		if ((p_Orientation & Orientation::FlipVertical) == Orientation::FlipVertical)
-			std::swap(texCoordTop, texCoordBottom);
-
-		SpriteBatchItem& item1 = GetNextItem(p_Texture, p_Depth);
-		SpriteBatchItem& item2 = GetNextItem(p_Texture, p_Depth);
-
-		// Top left vertex.
-		SetVertex(item1.VertexA,
-			p_Position.X + originX * cosAngle - originY * sinAngle,
-			p_Position.Y + originX * sinAngle + originY * cosAngle,
-			p_Color,
-			texCoordLeft, texCoordTop);
-
-		// Top right vertex. (2)
-		SetVertex(item1.VertexC,
-			p_Position.X + (originX + sizeX) * cosAngle - originY * sinAngle,
-			p_Position.Y + (originX + sizeX) * sinAngle + originY * cosAngle,
-			p_Color,
-			texCoordRight, texCoordTop);
-
-		SetVertex(item2.VertexA,
-			p_Position.X + (originX + sizeX) * cosAngle - originY * sinAngle,
-			p_Position.Y + (originX + sizeX) * sinAngle + originY * cosAngle,
-			p_Color,
-			texCoordRight, texCoordTop);
-
-		// Bottom left vertex. (2)
-		SetVertex(item1.VertexB,
-			p_Position.X + originX * cosAngle - (originY + sizeY) * sinAngle,
-			p_Position.Y + originX * sinAngle + (originY + sizeY) * cosAngle,
-			p_Color,
-			texCoordLeft, texCoordBottom);
-
-		SetVertex(item2.VertexB,
-			p_Position.X + originX * cosAngle - (originY + sizeY) * sinAngle,
-			p_Position.Y + originX * sinAngle + (originY + sizeY) * cosAngle,
-			p_Color,
-			texCoordLeft, texCoordBottom);
-
-		// Bottom right vertex.
-		SetVertex(item2.VertexC,
-			p_Position.X + (originX + sizeX) * cosAngle - (originY + sizeY) * sinAngle,
-			p_Position.Y + (originX + sizeX) * sinAngle + (originY + sizeY) * cosAngle,
-			p_Color,
-			texCoordRight, texCoordBottom);
+	bool SpriteBatch::DrawSprites(const Texture& p_Texture, const SpriteDescriptors& p_Sprites)
+	{
+		if (!m_WithinDrawPair)
+		{
+			SDL_Log("[SpriteBatch::DrawSprites] Must start a draw pair first.");
+			return false;
+		}
 
-		return true;
+		bool result = m_Recorder.DrawSprites(p_Texture, p_Sprites);
+		FlushFullRecorder();
+
+		return result;
 	}
 
 	bool SpriteBatch::DrawString(const SAGE::IFont* const p_Font, const std::string& p_String, const Vector2& p_Position, const Color& p_Color, float p_Depth)
@@ -564,323 +699,675 @@ namespace SAGE
 			return false;
 		}
 
-		const Texture& texture = p_Font->GetTexture();
+		bool result = m_Recorder.DrawString(p_Font, p_String, p_Position, p_Color, p_Origin, p_Rotation, p_Scale, p_Orientation, p_Depth);
+		FlushFullRecorder();
+
+		return result;
+	}
 
-		float textureWidth = static_cast<float>(texture.GetWidth());
-		float textureHeight = static_cast<float>(texture.GetHeight());
+	bool SpriteBatch::PrepareRecorder(SpriteRecorder& p_Recorder) const
+	{
+		if (m_VertexArrayObject == 0)
+		{
+			SDL_Log("[SpriteBatch::PrepareRecorder] The sprite batch must be initialized first.");
+			return false;
+		}
+
+		// Recorders only need what the batch's own recorder would use.
+		p_Recorder.Reset(m_BlankTexture.GetID(), m_Instancing);
+		p_Recorder.SetTextCaching(m_TextCaching);
+		if (m_Culling && m_WithinDrawPair)
+			p_Recorder.SetCullBounds(m_CullMinimum, m_CullMaximum);
+
+		return true;
+	}
 
-		float lineSpacing = p_Font->GetLineSpacing();
+	bool SpriteBatch::Submit(const SpriteRecorder& p_Recorder)
+	{
+		if (!m_WithinDrawPair)
+		{
+			SDL_Log("[SpriteBatch::Submit] Must start a draw pair first.");
+			return false;
+		}
+
+		if (p_Recorder.IsInstancing() != m_Instancing)
+		{
+			SDL_Log("[SpriteBatch::Submit] Recorder was not prepared by this sprite batch.");
+			return false;
+		}
+
+		// Sorted batches read each recorder once, at End.
+		bool sorted = m_SortMode != SortMode::None && m_SortMode != SortMode::Immediate;
+		if (sorted)
+		{
+			if (std::find(m_SubmittedRecorders.begin(), m_SubmittedRecorders.end(), &p_Recorder) != m_SubmittedRecorders.end())
+			{
+				SDL_Log("[SpriteBatch::Submit] Recorder was already submitted in this draw pair.");
+				return false;
+			}
 
-		float correctionX = 1.0f / textureWidth;
-		float correctionY = 1.0f / textureHeight;
+			m_SubmittedRecorders.push_back(&p_Recorder);
+		}
 
-		float originX = -p_Origin.X * p_Scale.X;
-		float originY = -p_Origin.Y * p_Scale.Y;
+		m_SubmittedCount += p_Recorder.GetSubmittedCount();
+		m_CulledCount += p_Recorder.GetCulledCount();
 
-		float cosAngle = cosf(p_Rotation);
-		float sinAngle = sinf(p_Rotation);
+		if (p_Recorder.GetItemCount() == 0)
+			return true;
 
-		float offsetX = 0.0f;
-		float offsetY = 0.0f;
+		// Captured items are copied, since the packet outlives the recorder.
+		if (m_CapturePass != nullptr)
+		{
+			if (!sorted)
+				m_Recorder.Append(p_Recorder);
+			else
+				m_CapturePass->Submitted.Append(p_Recorder);
 
-		std::vector<std::string> lines;
-		String::Split(p_String, "\n", lines);
+			return true;
+		}
 
-		for (std::string line : lines)
+		// Unsorted batches draw in call order, so everything recorded so far goes first.
+		if (!sorted)
 		{
-			for (char character : line)
+			if (m_Recorder.GetItemCount() > 0)
 			{
-				Rectangle textureBounds = p_Font->GetCharacterBounds(character);
-
-				float sizeX = textureBounds.Width * p_Scale.X;
-				float sizeY = textureBounds.Height * p_Scale.Y;
-
-				float texCoordTop = textureBounds.Y / textureHeight + correctionY;
-				float texCoordBottom = (textureBounds.Y + textureBounds.Height) / textureHeight - correctionY;
-				float texCoordLeft = textureBounds.X / textureWidth + correctionX;
-				float texCoordRight = (textureBounds.X + textureBounds.Width) / textureWidth - correctionX;
-
-				SpriteBatchItem& item1 = GetNextItem(texture, p_Depth);
-				SpriteBatchItem& item2 = GetNextItem(texture, p_Depth);
-
-				// Top left vertex.
-				SetVertex(item1.VertexA,
-					p_Position.X + originX + offsetX, p_Position.Y + originY + offsetY,
-					p_Color,
-					texCoordLeft, texCoordTop);
-
-				// Top right vertex. (2)
-				SetVertex(item1.VertexC,
-					p_Position.X + originX + sizeX + offsetX, p_Position.Y + originY + offsetY,
-					p_Color,
-					texCoordRight, texCoordTop);
-
-				SetVertex(item2.VertexA,
-					p_Position.X + originX + sizeX + offsetX, p_Position.Y + originY + offsetY,
-					p_Color,
-					texCoordRight, texCoordTop);
-
-				// Bottom left vertex. (2)
-				SetVertex(item1.VertexB,
-					p_Position.X + originX + offsetX, p_Position.Y + originY + sizeY + offsetY,
-					p_Color,
-					texCoordLeft, texCoordBottom);
-
-				SetVertex(item2.VertexB,
-					p_Position.X + originX + offsetX, p_Position.Y + originY + sizeY + offsetY,
-					p_Color,
-					texCoordLeft, texCoordBottom);
-
-				// Bottom right vertex.
-				SetVertex(item2.VertexC,
-					p_Position.X + originX + sizeX + offsetX, p_Position.Y + originY + sizeY + offsetY,
-					p_Color,
-					texCoordRight, texCoordBottom);
-
-				TransformVerticesAbout(item1, p_Position, cosAngle, sinAngle, p_Orientation);
-				TransformVerticesAbout(item2, p_Position, cosAngle, sinAngle, p_Orientation);
-
-				offsetX += p_Font->GetCharacterSpacing(character) * p_Scale.X;
+				RenderRecorder(m_Recorder);
+				m_Recorder.Clear();
 			}
 
-			offsetX = 0.0f;
-			offsetY += lineSpacing * p_Scale.Y;
+			RenderRecorder(p_Recorder);
+
+			return true;
 		}
 
-		return false;
+		// Sorted batches merge every submitted recorder by sort key at End.
+		return true;
 	}
 
 	bool SpriteBatch::End()
 	{
+		SAGE_PROFILE_ZONE("SpriteBatch::End");
+
 		if (!m_WithinDrawPair)
 		{
 			SDL_Log("[SpriteBatch::End] Cannot end a pair without starting.");
 			return false;
 		}
 
-		switch (m_SortMode)
+		if (m_CapturePass != nullptr)
 		{
-			case SortMode::Texture:
-				std::sort(std::begin(m_BatchItemList), std::end(m_BatchItemList), [](const SpriteBatchItem& p_ItemA, const SpriteBatchItem& p_ItemB) { return p_ItemA.TextureID > p_ItemB.TextureID; });
-				break;
-			case SortMode::FrontToBack:
-				std::sort(std::begin(m_BatchItemList), std::end(m_BatchItemList), [](const SpriteBatchItem& p_ItemA, const SpriteBatchItem& p_ItemB) { return p_ItemA.Depth > p_ItemB.Depth; });
-				break;
-			case SortMode::BackToFront:
-				std::sort(std::begin(m_BatchItemList), std::end(m_BatchItemList), [](const SpriteBatchItem& p_ItemA, const SpriteBatchItem& p_ItemB) { return p_ItemA.Depth < p_ItemB.Depth; });
-				break;
-			case SortMode::Immediate:
-			case SortMode::None:
-				break;
+			m_SubmittedCount += m_Recorder.GetSubmittedCount();
+			m_CulledCount += m_Recorder.GetCulledCount();
+
+			// The pass takes the recorded pages and hands back its old, empty ones.
+			m_CapturePass->Recorder.Swap(m_Recorder);
+			m_Recorder.Clear();
+			m_CapturePass = nullptr;
+			m_WithinDrawPair = false;
+
+			return true;
+		}
+
+		if (m_SortMode == SortMode::None || m_SortMode == SortMode::Immediate)
+		{
+			if (m_Recorder.GetItemCount() > 0)
+				RenderRecorder(m_Recorder);
+		}
+		else
+		{
+			RenderSorted();
 		}
 
+		m_SubmittedCount += m_Recorder.GetSubmittedCount();
+		m_CulledCount += m_Recorder.GetCulledCount();
+
+		m_Recorder.Clear();
+		m_SubmittedRecorders.clear();
+		m_WithinDrawPair = false;
+
+		return true;
+	}
+
+	void SpriteBatch::ApplyRenderState()
+	{
 		switch (m_BlendMode)
 		{
 			case BlendMode::None:
-				glDisable(GL_BLEND);
+				RenderState::SetBlend(false);
 				break;
 			case BlendMode::Premultiplied:
-				glEnable(GL_BLEND);
-				glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+				RenderState::SetBlend(true, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 				break;
 			case BlendMode::AlphaBlended:
-				glEnable(GL_BLEND);
-				glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+				RenderState::SetBlend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 				break;
 			case BlendMode::Additive:
-				glEnable(GL_BLEND);
-				glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+				RenderState::SetBlend(true, GL_SRC_ALPHA, GL_ONE);
 				break;
 		}
 
 		switch (m_RasterizerState)
 		{
 			case RasterizerState::None:
-				glDisable(GL_CULL_FACE);
+				RenderState::SetCulling(false);
 				break;
 			case RasterizerState::CullClockwise:
-				glEnable(GL_CULL_FACE);
-				glCullFace(GL_FRONT);
+				RenderState::SetCulling(true, GL_FRONT);
 				break;
 			case RasterizerState::CullCounterClockwise:
-				glEnable(GL_CULL_FACE);
-				glCullFace(GL_BACK);
+				RenderState::SetCulling(true, GL_BACK);
 				break;
 		}
+	}
 
-		if (m_ItemCount > 0)
-			Render();
+	void SpriteBatch::Sort()
+	{
+		Uint64 start = SDL_GetPerformanceCounter();
 
-		m_WithinDrawPair = false;
+		// The batch's own items go first, then each submitted recorder in turn; the stable sort keeps that order for ties.
+		int count = m_Recorder.GetItemCount();
+		for (const SpriteRecorder* recorder : m_SubmittedRecorders)
+		{
+			count += recorder->GetItemCount();
+		}
 
-		return true;
+		if ((int)m_SortEntries.size() < count)
+		{
+			m_SortEntries.resize(count);
+			m_SortScratch.resize(count);
+		}
+
+		int sequence = 0;
+		for (int r = -1; r < (int)m_SubmittedRecorders.size(); ++r)
+		{
+			const SpriteRecorder* recorder = r < 0 ? &m_Recorder : m_SubmittedRecorders[r];
+			int itemCount = recorder->GetItemCount();
+
+			for (int i = 0; i < itemCount; ++i)
+			{
+				SpriteBatchSortEntry& entry = m_SortEntries[sequence];
+				entry.Key = GetSortKey(recorder->GetItem(i));
+				entry.Recorder = recorder;
+				entry.Index = i;
+				sequence++;
+			}
+		}
+
+		if (count > 1)
+			RadixSort(m_SortEntries, m_SortScratch, count);
+
+		m_RenderCount = count;
+
+		m_Stats.SortMilliseconds += (SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency();
+	}
+
+	void SpriteBatch::RenderRecorder(const SpriteRecorder& p_Recorder)
+	{
+		// Draw a single recorder in the order it was recorded.
+		m_IsSorted = false;
+		m_RenderRecorder = &p_Recorder;
+		m_RenderCount = p_Recorder.GetItemCount();
+
+		Render();
+	}
+
+	void SpriteBatch::RenderSorted()
+	{
+		Sort();
+
+		if (m_RenderCount == 0)
+			return;
+
+		m_IsSorted = true;
+		m_RenderRecorder = nullptr;
+
+		Render();
+	}
+
+	void SpriteBatch::FlushFullRecorder()
+	{
+		// Unsorted batches draw in call order, so a full batch can be drawn right away.
+		if (m_SortMode != SortMode::None && m_SortMode != SortMode::Immediate)
+			return;
+
+		// Captured pairs keep everything for the replay, which splits it up again.
+		if (m_CapturePass != nullptr)
+			return;
+
+		if (m_Recorder.GetItemCount() < MaxBatchSize)
+			return;
+
+		m_Stats.CapacityFlushes++;
+
+		RenderRecorder(m_Recorder);
+		m_Recorder.Clear();
 	}
 
 	void SpriteBatch::Render()
 	{
-		int length = 0;
-		int texID = -1;
+		int issuedCallCount = RenderState::GetIssuedCallCount();
+		int textureBindCount = RenderState::GetTextureBindCount();
+
+		ApplyRenderState();
+
+		// The GPU buffers hold MaxBatchSize items, so larger batches are drawn in several ranges.
+		for (int first = 0; first < m_RenderCount; first += MaxBatchSize)
+		{
+			if (first > 0)
+				m_Stats.CapacityFlushes++;
+
+			RenderRange(first, std::min(m_RenderCount - first, static_cast<int>(MaxBatchSize)));
+		}
+
+		// Leave the pair's effect bound.
+		if (m_UsingInstanceEffect)
+		{
+			m_Effect->Use();
+			m_UsingInstanceEffect = false;
+		}
+
+		m_Stats.StateChanges += RenderState::GetIssuedCallCount() - issuedCallCount;
+		m_Stats.TextureSwitches += RenderState::GetTextureBindCount() - textureBindCount;
+	}
+
+	void SpriteBatch::RenderRange(int p_First, int p_Length)
+	{
+		// Only quads go through the ring, so instanced items must not reserve space in it.
+		int quadTotal = p_Length;
+		if (m_Instancing)
+		{
+			quadTotal = 0;
+			for (int i = p_First; i < p_First + p_Length; ++i)
+			{
+				const SpriteRecorder* recorder;
+				if (GetSortedItem(i, recorder).InstanceIndex < 0)
+					quadTotal++;
+			}
+		}
+
+		// Gather the range into one vertex section and one instance buffer, splitting it into runs.
+		void* section = quadTotal > 0 ? AcquireVertexSection(quadTotal * 4) : nullptr;
 
-		for (int i = 0; i < m_ItemCount; ++i)
+		int quadCount = 0;
+		int instanceCount = 0;
+		int runIndex = -1;
+
+		m_DrawRuns.clear();
+
+		for (int i = p_First; i < p_First + p_Length; ++i)
 		{
-			SpriteBatchItem& item = m_BatchItemList[i];
+			const SpriteRecorder* recorder;
+			const SpriteBatchItem& item = GetSortedItem(i, recorder);
+			bool instanced = item.InstanceIndex >= 0;
 
-			if (item.TextureID != texID)
+			// Stay in the current run while it has the texture or a free slot for it.
+			int slot = -1;
+			if (runIndex >= 0 && m_DrawRuns[runIndex].Instanced == instanced)
 			{
-				if (texID != -1)
-				{
-					Flush(texID, length);
-				}
-				length = 0;
-				texID = item.TextureID;
+				slot = GetRunTextureSlot(m_DrawRuns[runIndex], item.TextureID);
 			}
 
-			if (length * 6 > MaxVertexCount)
+			if (slot < 0)
 			{
-				Flush(texID, length);
-				length = 0;
+				if (runIndex >= 0 && m_DrawRuns[runIndex].Instanced == instanced)
+					m_Stats.TextureFlushes++;
+
+				SpriteBatchRun run;
+				run.First = instanced ? instanceCount : quadCount;
+				run.Length = 0;
+				run.Instanced = instanced;
+				run.TextureCount = 0;
+
+				m_DrawRuns.push_back(run);
+				runIndex = (int)m_DrawRuns.size() - 1;
+
+				slot = GetRunTextureSlot(m_DrawRuns[runIndex], item.TextureID);
 			}
 
-			m_VertexBuffer[length * 3 + 0] = item.VertexA;
-			m_VertexBuffer[length * 3 + 1] = item.VertexB;
-			m_VertexBuffer[length * 3 + 2] = item.VertexC;
+			m_DrawRuns[runIndex].Length++;
 
-			length++;
+			if (instanced)
+				m_InstanceBuffer[instanceCount++] = recorder->GetInstance(item.InstanceIndex);
+			else
+				GatherQuad(section, quadCount++, item, slot);
 		}
 
-		Flush(texID, length);
+		m_Stats.Quads += quadCount + instanceCount;
+		m_Stats.Triangles += (quadCount + instanceCount) * 2;
+		m_Stats.Vertices += (quadCount + instanceCount) * 4;
+
+		// Upload once, then draw each run as a range of what was uploaded.
+		UploadVertexSection(quadCount * 4);
+		UploadInstances(instanceCount);
+
+		for (const SpriteBatchRun& run : m_DrawRuns)
+		{
+			if (run.Instanced)
+				FlushInstances(run);
+			else
+				Flush(run);
+		}
+
+		ReleaseVertexSection(quadCount * 4);
 	}
 
-	void SpriteBatch::Flush(int p_TextureID, int p_Length)
+	void SpriteBatch::Flush(const SpriteBatchRun& p_Run)
 	{
+		SAGE_PROFILE_ZONE("SpriteBatch::Flush");
+
 		// Ensure there's something to draw.
-		if (p_Length == 0)
+		if (p_Run.Length == 0)
 			return;
 
-		// Enable textures and bind the current ID.
-		glEnable(GL_TEXTURE_2D);
-		glBindTexture(GL_TEXTURE_2D, p_TextureID);
+		// Switch back from the instancing effect if the previous run used it.
+		if (m_UsingInstanceEffect)
+		{
+			m_Effect->Use();
+			m_UsingInstanceEffect = false;
+		}
 
-		// Bind the vertex array.
-		glBindVertexArray(m_VertexArrayObject);
+		// Bind each of the run's textures to its slot.
+		for (int i = 0; i < p_Run.TextureCount; ++i)
+		{
+			RenderState::BindTexture(i, p_Run.TextureIDs[i]);
+		}
 
-		// Bind the vertex buffer.
-		glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
+		// Bind the vertex array, which also holds the index buffer.
+		RenderState::BindVertexArray(m_VertexArrayObject);
 
-		// Option 1: Insert subset into buffer.
-		glBufferSubData(GL_ARRAY_BUFFER, 0, p_Length * 4 * sizeof(VertexPositionColorTexture), m_VertexBuffer);
+		// Offset to where this range was written in the ring.
+		GLint baseVertex = p_Run.First * 4;
+		if (m_BufferMode == BufferMode::PersistentRing)
+		{
+			baseVertex += m_RangeBaseVertex;
+		}
 
-		// Option 2: Write to buffer mapping.
-		/*
-		glBufferData(GL_ARRAY_BUFFER, m_VertexBuffer.size() * sizeof(VertexPositionColorTexture), nullptr, GL_DYNAMIC_DRAW);
-		VertexPositionColorTexture* map = reinterpret_cast<VertexPositionColorTexture*>(
-		glMapBufferRange(GL_ARRAY_BUFFER,
-		0,
-		p_Length * sizeof(VertexPositionColorTexture),
-		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT)
-		);
-		std::copy(m_VertexBuffer.begin(), m_VertexBuffer.end(), map);
-		glUnmapBuffer(GL_ARRAY_BUFFER);
-		*/
+		// Draw the range.
+		IRenderDevice::Get().DrawElementsBaseVertex(GL_TRIANGLES, p_Run.Length * 6, GL_UNSIGNED_SHORT, nullptr, baseVertex);
 
-		// Bind the element buffer and draw.
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferObject);
-		glDrawElements(GL_TRIANGLES, p_Length * 3, GL_UNSIGNED_SHORT, nullptr);
+		m_FlushCount++;
+		m_Stats.DrawCalls++;
+	}
 
-		// Clear bindings.
-		glBindVertexArray(0);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	int SpriteBatch::GetRunTextureSlot(SpriteBatchRun& p_Run, unsigned int p_TextureID)
+	{
+		for (int i = 0; i < p_Run.TextureCount; ++i)
+		{
+			if (p_Run.TextureIDs[i] == p_TextureID)
+				return i;
+		}
+
+		// Instanced runs always sample a single texture.
+		int capacity = p_Run.Instanced ? 1 : m_RunTextureSlots;
+		if (p_Run.TextureCount >= capacity)
+			return -1;
+
+		p_Run.TextureIDs[p_Run.TextureCount] = p_TextureID;
+
+		return p_Run.TextureCount++;
+	}
+
+	void SpriteBatch::FlushInstances(const SpriteBatchRun& p_Run)
+	{
+		SAGE_PROFILE_ZONE("SpriteBatch::FlushInstances");
+
+		// Ensure there's something to draw.
+		if (p_Run.Length == 0)
+			return;
+
+		// Switch to the instancing effect with the batch's camera matrices.
+		if (!m_UsingInstanceEffect)
+		{
+			m_InstanceEffect.Use();
+			m_InstanceEffect.SetProjection(m_ProjectionMatrix);
+			m_InstanceEffect.SetModelView(m_ModelViewMatrix);
+			m_UsingInstanceEffect = true;
+		}
+
+		// Bind the current texture.
+		RenderState::BindTexture(0, p_Run.TextureIDs[0]);
+
+		// Point the per-instance attributes at the first instance of the run.
+		GLsizei sizeVSI = sizeof(VertexSpriteInstance);
+		GLsizei base = p_Run.First * sizeVSI;
+
+		RenderState::BindVertexArray(m_InstanceArrayObject);
+		RenderState::BindBuffer(GL_ARRAY_BUFFER, m_InstanceBufferObject);
+
+		#define BUFFER_OFFSET(i) ((char*)0 + (i))
+
+		IRenderDevice::Get().VertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeVSI, BUFFER_OFFSET(base + offsetof(VertexSpriteInstance, Position)));
+		IRenderDevice::Get().VertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeVSI, BUFFER_OFFSET(base + offsetof(VertexSpriteInstance, Size)));
+		IRenderDevice::Get().VertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeVSI, BUFFER_OFFSET(base + offsetof(VertexSpriteInstance, Origin)));
+		IRenderDevice::Get().VertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeVSI, BUFFER_OFFSET(base + offsetof(VertexSpriteInstance, Rotation)));
+		IRenderDevice::Get().VertexAttribPointer(4, 4, GL_UNSIGNED_SHORT, GL_TRUE, sizeVSI, BUFFER_OFFSET(base + offsetof(VertexSpriteInstance, TexCoordMin)));
+		IRenderDevice::Get().VertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeVSI, BUFFER_OFFSET(base + offsetof(VertexSpriteInstance, Color)));
+		IRenderDevice::Get().VertexAttribIPointer(6, 1, GL_UNSIGNED_INT, sizeVSI, BUFFER_OFFSET(base + offsetof(VertexSpriteInstance, Flags)));
+
+		#undef BUFFER_OFFSET
 
-		// Disable textures.
-		glDisable(GL_TEXTURE_2D);
+		// Four strip vertices per instance: top left, bottom left, top right, bottom right.
+		IRenderDevice::Get().DrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, p_Run.Length);
 
 		m_FlushCount++;
+		m_Stats.DrawCalls++;
 	}
 
-	SpriteBatchItem& SpriteBatch::GetNextItem(const Texture& p_Texture, float p_Depth)
+	void* SpriteBatch::AcquireVertexSection(int p_Length)
 	{
-		SpriteBatchItem& item = m_BatchItemList[m_ItemCount++];
-		item.TextureID = p_Texture.GetID();
-		item.Depth = p_Depth;
+		if (m_BufferMode != BufferMode::PersistentRing)
+		{
+			return &m_VertexBuffer.front();
+		}
+
+		// A frame that outgrows its section carries on in the next one.
+		if (m_SectionOffset + p_Length > MaxVertexCount)
+		{
+			AdvanceVertexSection();
+		}
+
+		// Wait, on the first write only, until the GPU has finished reading this section from an earlier frame.
+		GLsync& fence = m_SectionFences[m_SectionIndex];
+		if (fence != nullptr)
+		{
+			GLenum result = IRenderDevice::Get().ClientWaitSync(fence, 0, 0);
+			while (result == GL_TIMEOUT_EXPIRED)
+			{
+				result = IRenderDevice::Get().ClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+			}
+
+			if (result == GL_WAIT_FAILED)
+			{
+				SDL_Log("[SpriteBatch::AcquireVertexSection] Failed waiting on ring section fence.");
+			}
+
+			IRenderDevice::Get().DeleteSync(fence);
+			fence = nullptr;
+		}
 
-		return item;
+		// Ranges are written one after another within the section.
+		m_RangeBaseVertex = m_SectionIndex * MaxVertexCount + m_SectionOffset;
+
+		return m_MappedVertices + m_RangeBaseVertex * m_VertexStride;
 	}
 
-	void SpriteBatch::SetVertexPosition(VertexPositionColorTexture& p_Vertex, float p_X, float p_Y)
+	void SpriteBatch::UploadVertexSection(int p_Length)
 	{
-		p_Vertex.Position.X = p_X;
-		p_Vertex.Position.Y = p_Y;
+		// Writes into a mapped section count as uploads too.
+		m_UploadedByteCount += p_Length * m_VertexStride;
+		m_Stats.UploadedBytes += p_Length * m_VertexStride;
+
+		// Persistent sections are coherent, so only the dynamic buffer needs an upload.
+		if (m_BufferMode == BufferMode::PersistentRing || p_Length == 0)
+			return;
+
+		RenderState::BindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
+		IRenderDevice::Get().BufferData(GL_ARRAY_BUFFER, MaxVertexCount * m_VertexStride, nullptr, GL_DYNAMIC_DRAW);
+		IRenderDevice::Get().BufferSubData(GL_ARRAY_BUFFER, 0, p_Length * m_VertexStride, &m_VertexBuffer.front());
 	}
 
-	void SpriteBatch::SetVertexColor(VertexPositionColorTexture& p_Vertex, const Color& p_Color)
+	void SpriteBatch::GatherQuad(void* p_Section, int p_Index, const SpriteBatchItem& p_Item, unsigned int p_Slot)
 	{
-		p_Vertex.Color.R = p_Color.GetRed();
-		p_Vertex.Color.G = p_Color.GetGreen();
-		p_Vertex.Color.B = p_Color.GetBlue();
-		p_Vertex.Color.A = p_Color.GetAlpha();
+		unsigned char* vertices = static_cast<unsigned char*>(p_Section) + p_Index * 4 * m_VertexStride;
+
+		GatherVertex(vertices + m_VertexStride * 0, p_Item.VertexA, p_Slot);
+		GatherVertex(vertices + m_VertexStride * 1, p_Item.VertexB, p_Slot);
+		GatherVertex(vertices + m_VertexStride * 2, p_Item.VertexC, p_Slot);
+		GatherVertex(vertices + m_VertexStride * 3, p_Item.VertexD, p_Slot);
 	}
 
-	void SpriteBatch::SetVertexTexCoords(VertexPositionColorTexture& p_Vertex, float p_U, float p_V)
+	void SpriteBatch::GatherVertex(unsigned char* p_Destination, const VertexPositionColorTexture& p_Vertex, unsigned int p_Slot)
 	{
-		p_Vertex.TexCoord.X = p_U;
-		p_Vertex.TexCoord.Y = p_V;
+		GLsizei slotOffset;
+
+		if (m_VertexFormat == VertexFormat::Packed)
+		{
+			PackVertex(*reinterpret_cast<VertexPositionColorTexturePacked*>(p_Destination), p_Vertex);
+			slotOffset = sizeof(VertexPositionColorTexturePacked);
+		}
+		else
+		{
+			*reinterpret_cast<VertexPositionColorTexture*>(p_Destination) = p_Vertex;
+			slotOffset = sizeof(VertexPositionColorTexture);
+		}
+
+		if (m_TextureSlots > 1)
+		{
+			memcpy(p_Destination + slotOffset, &p_Slot, sizeof(p_Slot));
+		}
 	}
 
-	void SpriteBatch::SetVertex(VertexPositionColorTexture& p_Vertex, float p_X, float p_Y, const Color& p_Color, float p_U, float p_V)
+	void SpriteBatch::UploadInstances(int p_Length)
 	{
-		SetVertexPosition(p_Vertex, p_X, p_Y);
-		SetVertexColor(p_Vertex, p_Color);
-		SetVertexTexCoords(p_Vertex, p_U, p_V);
+		if (p_Length == 0)
+			return;
+
+		GLsizei sizeVSI = sizeof(VertexSpriteInstance);
+		m_UploadedByteCount += p_Length * sizeVSI;
+		m_Stats.UploadedBytes += p_Length * sizeVSI;
+
+		RenderState::BindBuffer(GL_ARRAY_BUFFER, m_InstanceBufferObject);
+		IRenderDevice::Get().BufferData(GL_ARRAY_BUFFER, MaxBatchSize * sizeVSI, nullptr, GL_DYNAMIC_DRAW);
+		IRenderDevice::Get().BufferSubData(GL_ARRAY_BUFFER, 0, p_Length * sizeVSI, &m_InstanceBuffer.front());
 	}
 
-	void SpriteBatch::TransformVerticesAbout(SpriteBatchItem& p_Item, const Vector2& p_Position, float p_CosAngle, float p_SinAngle, Orientation p_Orientation)
+	void SpriteBatch::ReleaseVertexSection(int p_Length)
 	{
-		RotateVerticesAbout(p_Item, p_Position, p_CosAngle, p_SinAngle);
-		FlipVerticesAbout(p_Item, p_Position, p_Orientation);
+		if (m_BufferMode != BufferMode::PersistentRing)
+			return;
+
+		m_SectionOffset += p_Length;
 	}
 
-	void SpriteBatch::RotateVerticesAbout(SpriteBatchItem& p_Item, const Vector2& p_Position, float p_CosAngle, float p_SinAngle)
+	void SpriteBatch::AdvanceVertexSection()
 	{
-		RotateVertexAbout(p_Item.VertexA, p_Position, p_CosAngle, p_SinAngle);
-		RotateVertexAbout(p_Item.VertexB, p_Position, p_CosAngle, p_SinAngle);
-		RotateVertexAbout(p_Item.VertexC, p_Position, p_CosAngle, p_SinAngle);
+		// Fence the draws that read this section and move on to the next one.
+		m_SectionFences[m_SectionIndex] = IRenderDevice::Get().FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_SectionIndex = (m_SectionIndex + 1) % RingSectionCount;
+		m_SectionOffset = 0;
 	}
 
-	void SpriteBatch::FlipVerticesAbout(SpriteBatchItem& p_Item, const Vector2& p_Position, Orientation p_Orientation)
+	const SpriteBatchItem& SpriteBatch::GetSortedItem(int p_Position, const SpriteRecorder*& p_Recorder) const
 	{
-		FlipVertexAbout(p_Item.VertexA, p_Position, p_Orientation);
-		FlipVertexAbout(p_Item.VertexB, p_Position, p_Orientation);
-		FlipVertexAbout(p_Item.VertexC, p_Position, p_Orientation);
+		if (m_IsSorted)
+		{
+			const SpriteBatchSortEntry& entry = m_SortEntries[p_Position];
+			p_Recorder = entry.Recorder;
+
+			return entry.Recorder->GetItem(entry.Index);
+		}
+
+		p_Recorder = m_RenderRecorder;
+
+		return m_RenderRecorder->GetItem(p_Position);
 	}
 
-	void SpriteBatch::RotateVertexAbout(VertexPositionColorTexture& p_Vertex, const Vector2& p_Position, float p_CosAngle, float p_SinAngle)
+	unsigned long long SpriteBatch::GetSortKey(const SpriteBatchItem& p_Item) const
 	{
-		// Shift to transform origin.
-		p_Vertex.Position.X -= p_Position.X;
-		p_Vertex.Position.Y -= p_Position.Y;
+		// The upper half orders by the sort mode. Under depth, the lower half groups equal depths by
+		// texture so they can share runs. Ties keep the order Sort lays entries out in.
+		unsigned int primary = 0;
+		unsigned int secondary = 0;
 
-		// Rotate the vertex about the new origin.
-		float rotationX = p_Vertex.Position.X * p_CosAngle - p_Vertex.Position.Y * p_SinAngle;
-		float rotationY = p_Vertex.Position.X * p_SinAngle + p_Vertex.Position.Y * p_CosAngle;
+		switch (m_SortMode)
+		{
+			case SortMode::Texture:
+				primary = ~p_Item.TextureID;
+				break;
+			case SortMode::FrontToBack:
+				primary = ~GetSortableDepth(p_Item.Depth);
+				secondary = p_Item.TextureID;
+				break;
+			case SortMode::BackToFront:
+				primary = GetSortableDepth(p_Item.Depth);
+				secondary = p_Item.TextureID;
+				break;
+			case SortMode::Immediate:
+			case SortMode::None:
+				break;
+		}
 
-		// Shift back to the original origin.
-		p_Vertex.Position.X = rotationX + p_Position.X;
-		p_Vertex.Position.Y = rotationY + p_Position.Y;
+		return (static_cast<unsigned long long>(primary) << 32) | secondary;
 	}
 
-	void SpriteBatch::FlipVertexAbout(VertexPositionColorTexture& p_Vertex, const Vector2& p_Position, Orientation p_Orientation)
+	unsigned int SpriteBatch::GetSortableDepth(float p_Depth)
 	{
-		// Flip texture vertices horizontally.
-		if ((p_Orientation & Orientation::FlipHorizontal) == Orientation::FlipHorizontal)
+		// Map the float's bits so unsigned comparison matches float ordering.
+		unsigned int bits;
+		memcpy(&bits, &p_Depth, sizeof(bits));
+
+		if (bits & 0x80000000u)
+			return ~bits;
+
+		return bits | 0x80000000u;
+	}
+
+	void SpriteBatch::RadixSort(std::vector<SpriteBatchSortEntry>& p_Entries, std::vector<SpriteBatchSortEntry>& p_Scratch, int p_Count)
+	{
+		SpriteBatchSortEntry* source = &p_Entries.front();
+		SpriteBatchSortEntry* destination = &p_Scratch.front();
+
+		// Stable least-significant-digit passes over each byte of the key.
+		for (int shift = 0; shift < 64; shift += 8)
 		{
-			p_Vertex.Position.X = p_Position.X - (p_Vertex.Position.X - p_Position.X);
+			int counts[256] = { 0 };
+
+			for (int i = 0; i < p_Count; ++i)
+			{
+				counts[(source[i].Key >> shift) & 0xFF]++;
+			}
+
+			// Skip passes where every key shares the same digit.
+			if (counts[(source[0].Key >> shift) & 0xFF] == p_Count)
+				continue;
+
+			int offset = 0;
+			for (int i = 0; i < 256; ++i)
+			{
+				int count = counts[i];
+				counts[i] = offset;
+				offset += count;
+			}
+
+			for (int i = 0; i < p_Count; ++i)
+			{
+				destination[counts[(source[i].Key >> shift) & 0xFF]++] = source[i];
+			}
+
+			std::swap(source, destination);
 		}
 
-		// Flip texture vertices vertically.
-		if ((p_Orientation & Orientation::FlipVertical) == Orientation::FlipVertical)
+		// Make sure the result ends up in the entry list.
+		if (source != &p_Entries.front())
 		{
-			p_Vertex.Position.Y = p_Position.Y - (p_Vertex.Position.Y - p_Position.Y);
+			std::copy(source, source + p_Count, &p_Entries.front());
 		}
 	}
+
+	void SpriteBatch::PackVertex(VertexPositionColorTexturePacked& p_Packed, const VertexPositionColorTexture& p_Vertex)
+	{
+		p_Packed.Position = p_Vertex.Position;
+		SpriteRecorder::PackColor(p_Packed.Color, p_Vertex.Color.R, p_Vertex.Color.G, p_Vertex.Color.B, p_Vertex.Color.A);
+		SpriteRecorder::PackTexCoord(p_Packed.TexCoord, p_Vertex.TexCoord.X, p_Vertex.TexCoord.Y);
+	}
 }
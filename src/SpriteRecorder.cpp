@@ -0,0 +1,1166 @@
+// SpriteRecorder.cpp
+
+// SAGE Includes
+#include <SAGE/Math.hpp>
+#include <SAGE/SpriteRecorder.hpp>
+#include <SAGE/String.hpp>
+// SDL Includes
+#include <SDL2/SDL.h>
+// STL Includes
+#include <algorithm>
+// SIMD Includes
+#if defined __SSE2__ || defined _M_X64
+	#include <emmintrin.h>
+#endif
+
+namespace SAGE
+{
+	SpriteRecorder::SpriteRecorder()
+	{
+		m_BlankTextureID = 0;
+		m_Instancing = false;
+		m_ItemCount = 0;
+		m_InstanceCount = 0;
+		m_Culling = false;
+		m_CullSuspended = 0;
+		m_SubmittedCount = 0;
+		m_CulledCount = 0;
+		m_TextCaching = false;
+		m_FrameIndex = 0;
+	}
+
+	SpriteRecorder::~SpriteRecorder()
+	{
+	}
+
+	int SpriteRecorder::GetItemCount() const
+	{
+		return m_ItemCount;
+	}
+
+	int SpriteRecorder::GetInstanceCount() const
+	{
+		return m_InstanceCount;
+	}
+
+	bool SpriteRecorder::IsInstancing() const
+	{
+		return m_Instancing;
+	}
+
+	const SpriteBatchItem& SpriteRecorder::GetItem(int p_Index) const
+	{
+		return m_ItemPages[p_Index / ItemPageSize][p_Index % ItemPageSize];
+	}
+
+	const VertexSpriteInstance& SpriteRecorder::GetInstance(int p_Index) const
+	{
+		return m_InstanceList[p_Index];
+	}
+
+	bool SpriteRecorder::IsTextCaching() const
+	{
+		return m_TextCaching;
+	}
+
+	int SpriteRecorder::GetTextMeshCount() const
+	{
+		return static_cast<int>(m_TextMeshes.size());
+	}
+
+	bool SpriteRecorder::IsCulling() const
+	{
+		return m_Culling;
+	}
+
+	int SpriteRecorder::GetSubmittedCount() const
+	{
+		return m_SubmittedCount;
+	}
+
+	int SpriteRecorder::GetCulledCount() const
+	{
+		return m_CulledCount;
+	}
+
+	void SpriteRecorder::Reset(unsigned int p_BlankTextureID, bool p_Instancing)
+	{
+		m_BlankTextureID = p_BlankTextureID;
+		m_Instancing = p_Instancing;
+
+		// Counts cover everything recorded since the last reset, including flushed items.
+		m_Culling = false;
+		m_CullSuspended = 0;
+		m_SubmittedCount = 0;
+		m_CulledCount = 0;
+
+		Clear();
+	}
+
+	void SpriteRecorder::Clear()
+	{
+		// Pages are kept so the next frame can reuse them.
+		m_ItemCount = 0;
+		m_InstanceCount = 0;
+	}
+
+	void SpriteRecorder::Trim()
+	{
+		// Keep a single page around so the next frame doesn't start from nothing.
+		if (m_ItemPages.size() > 1)
+		{
+			m_ItemPages.resize(1);
+			m_ItemPages.shrink_to_fit();
+		}
+
+		std::vector<VertexSpriteInstance>().swap(m_InstanceList);
+		m_TextMeshes.clear();
+	}
+
+	void SpriteRecorder::Swap(SpriteRecorder& p_Other)
+	{
+		std::swap(m_BlankTextureID, p_Other.m_BlankTextureID);
+		std::swap(m_Instancing, p_Other.m_Instancing);
+		std::swap(m_ItemCount, p_Other.m_ItemCount);
+		std::swap(m_InstanceCount, p_Other.m_InstanceCount);
+		std::swap(m_SubmittedCount, p_Other.m_SubmittedCount);
+		std::swap(m_CulledCount, p_Other.m_CulledCount);
+		m_ItemPages.swap(p_Other.m_ItemPages);
+		m_InstanceList.swap(p_Other.m_InstanceList);
+	}
+
+	void SpriteRecorder::Append(const SpriteRecorder& p_Other)
+	{
+		for (int i = 0; i < p_Other.m_ItemCount; ++i)
+		{
+			const SpriteBatchItem& source = p_Other.GetItem(i);
+
+			// Instances are renumbered, since they land after the ones already recorded here.
+			if (source.InstanceIndex >= 0)
+			{
+				GetNextInstance(source.TextureID, source.Depth) = p_Other.GetInstance(source.InstanceIndex);
+
+				SpriteBatchItem& item = m_ItemPages[(m_ItemCount - 1) / ItemPageSize][(m_ItemCount - 1) % ItemPageSize];
+				int instanceIndex = item.InstanceIndex;
+				item = source;
+				item.InstanceIndex = instanceIndex;
+			}
+			else
+			{
+				GetNextItem(source.TextureID, source.Depth) = source;
+			}
+		}
+	}
+
+	void SpriteRecorder::SetTextCaching(bool p_Enabled)
+	{
+		m_TextCaching = p_Enabled;
+
+		if (!m_TextCaching)
+			m_TextMeshes.clear();
+	}
+
+	void SpriteRecorder::EndFrame()
+	{
+		m_FrameIndex++;
+		if (!m_TextMeshes.empty())
+			EvictTextMeshes();
+	}
+
+	void SpriteRecorder::SetCullBounds(const Vector2& p_Minimum, const Vector2& p_Maximum)
+	{
+		m_Culling = true;
+		m_CullMinimum = p_Minimum;
+		m_CullMaximum = p_Maximum;
+	}
+
+	void SpriteRecorder::DisableCulling()
+	{
+		m_Culling = false;
+	}
+
+
+	bool SpriteRecorder::DrawLine(const Vector2& p_PositionA, const Vector2& p_PositionB, const Color& p_Color, float p_Thickness, float p_Depth)
+	{
+		return DrawLine(p_PositionA, p_Color, p_PositionB, p_Color, p_Thickness, p_Depth);
+	}
+
+	bool SpriteRecorder::DrawLine(const Vector2& p_PositionA, const Color& p_ColorA, const Vector2& p_PositionB, const Color& p_ColorB, float p_Thickness, float p_Depth)
+	{
+		float halfThickness = p_Thickness / 2.0f;
+		if (!Accept(std::min(p_PositionA.X, p_PositionB.X) - halfThickness, std::min(p_PositionA.Y, p_PositionB.Y) - halfThickness,
+					std::max(p_PositionA.X, p_PositionB.X) + halfThickness, std::max(p_PositionA.Y, p_PositionB.Y) + halfThickness))
+			return true;
+
+		// Create the identity vector perpendicular to the line.
+		Vector2 perpendicular = Vector2(p_PositionA.Y - p_PositionB.Y, p_PositionB.X - p_PositionA.X);
+		perpendicular.Normalize();
+
+		SpriteBatchItem& item = GetNextItem(m_BlankTextureID, p_Depth);
+
+		// Top left vertex.
+		SetVertex(item.VertexA,
+			p_PositionA.X + perpendicular.X * p_Thickness / 2.0f, p_PositionA.Y + perpendicular.Y * p_Thickness / 2.0f,
+			p_ColorA,
+			0.0f, 1.0f);
+
+		// Bottom left vertex.
+		SetVertex(item.VertexB,
+			p_PositionB.X + perpendicular.X * p_Thickness / 2.0f, p_PositionB.Y + perpendicular.Y * p_Thickness / 2.0f,
+			p_ColorB,
+			0.0f, 0.0f);
+
+		// Top right vertex.
+		SetVertex(item.VertexC,
+			p_PositionA.X - perpendicular.X * p_Thickness / 2.0f, p_PositionA.Y - perpendicular.Y * p_Thickness / 2.0f,
+			p_ColorA,
+			1.0f, 1.0f);
+
+		// Bottom right vertex.
+		SetVertex(item.VertexD,
+			p_PositionB.X - perpendicular.X * p_Thickness / 2.0f, p_PositionB.Y - perpendicular.Y * p_Thickness / 2.0f,
+			p_ColorB,
+			1.0f, 0.0f);
+
+		return true;
+	}
+
+	bool SpriteRecorder::DrawLines(const std::vector<Vector2>& p_Positions, const Color& p_Color, float p_Thickness, float p_Depth)
+	{
+		return DrawLines(p_Positions.data(), static_cast<int>(p_Positions.size()), &p_Color, 1, p_Thickness, p_Depth);
+	}
+
+	bool SpriteRecorder::DrawLines(const std::vector<Vector2>& p_Positions, const std::vector<Color>& p_Colors, float p_Thickness, float p_Depth)
+	{
+		return DrawLines(p_Positions.data(), static_cast<int>(p_Positions.size()), p_Colors.data(), static_cast<int>(p_Colors.size()), p_Thickness, p_Depth);
+	}
+
+	bool SpriteRecorder::DrawLines(const Vector2* p_Positions, int p_PositionCount, const Color* p_Colors, int p_ColorCount, float p_Thickness, float p_Depth)
+	{
+		if (p_PositionCount < 2)
+		{
+			SDL_Log("[SpriteRecorder::DrawLines] Must supply at least 2 positions.");
+			return false;
+		}
+
+		if (p_ColorCount < 1)
+		{
+			SDL_Log("[SpriteRecorder::DrawLines] Must supply at least 1 color.");
+			return false;
+		}
+
+		for (int i = 0; i < p_PositionCount - 1; ++i)
+		{
+			if (!DrawLine(p_Positions[i], p_Colors[i % p_ColorCount], p_Positions[i + 1], p_Colors[(i + 1) % p_ColorCount], p_Thickness, p_Depth))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool SpriteRecorder::DrawLineLoop(const std::vector<Vector2>& p_Positions, const Color& p_Color, float p_Thickness, float p_Depth)
+	{
+		return DrawLineLoop(p_Positions.data(), static_cast<int>(p_Positions.size()), &p_Color, 1, p_Thickness, p_Depth);
+	}
+
+	bool SpriteRecorder::DrawLineLoop(const std::vector<Vector2>& p_Positions, const std::vector<Color>& p_Colors, float p_Thickness, float p_Depth)
+	{
+		return DrawLineLoop(p_Positions.data(), static_cast<int>(p_Positions.size()), p_Colors.data(), static_cast<int>(p_Colors.size()), p_Thickness, p_Depth);
+	}
+
+	bool SpriteRecorder::DrawLineLoop(const Vector2* p_Positions, int p_PositionCount, const Color* p_Colors, int p_ColorCount, float p_Thickness, float p_Depth)
+	{
+		if (p_PositionCount < 3)
+		{
+			SDL_Log("[SpriteRecorder::DrawLineLoop] Must supply at least 3 positions.");
+			return false;
+		}
+
+		if (p_ColorCount < 1)
+		{
+			SDL_Log("[SpriteRecorder::DrawLineLoop] Must supply at least 1 color.");
+			return false;
+		}
+
+		for (int i = 0; i < p_PositionCount; ++i)
+		{
+			if (!DrawLine(p_Positions[i], p_Colors[i % p_ColorCount],
+						  p_Positions[(i + 1) % p_PositionCount], p_Colors[(i + 1) % p_ColorCount],
+						  p_Thickness, p_Depth))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool SpriteRecorder::DrawCircle(const Vector2& p_Position, const Color& p_Color, float p_Radius, float p_Thickness, float p_Depth, const UnitCircle& p_Circle)
+	{
+		return DrawCircle(p_Position, &p_Color, 1, p_Radius, p_Thickness, p_Depth, p_Circle);
+	}
+
+	bool SpriteRecorder::DrawCircle(const Vector2& p_Position, const std::vector<Color>& p_Colors, float p_Radius, float p_Thickness, float p_Depth)
+	{
+		return DrawCircle(p_Position, p_Colors.data(), static_cast<int>(p_Colors.size()), p_Radius, p_Thickness, p_Depth);
+	}
+
+	bool SpriteRecorder::DrawCircle(const Vector2& p_Position, const Color* p_Colors, int p_ColorCount, float p_Radius, float p_Thickness, float p_Depth, const UnitCircle& p_Circle)
+	{
+		if (p_ColorCount < 1)
+		{
+			SDL_Log("[SpriteRecorder::DrawCircle] Must supply at least 1 color.");
+			return false;
+		}
+
+		float extent = p_Radius + p_Thickness / 2.0f;
+		if (!Accept(p_Position.X - extent, p_Position.Y - extent, p_Position.X + extent, p_Position.Y + extent))
+			return true;
+
+		const Vector2* points = p_Circle.GetPoints();
+		int segmentCount = p_Circle.GetSegmentCount();
+
+		// The circle was accepted as a whole, so its segments aren't tested again.
+		m_CullSuspended++;
+
+		for (int i = 0; i < segmentCount; ++i)
+		{
+			Vector2 positionA(p_Position.X + p_Radius * points[i].X, p_Position.Y + p_Radius * points[i].Y);
+			Vector2 positionB(p_Position.X + p_Radius * points[i + 1].X, p_Position.Y + p_Radius * points[i + 1].Y);
+
+			DrawLine(positionA, p_Colors[i % p_ColorCount], positionB, p_Colors[(i + 1) % p_ColorCount], p_Thickness, p_Depth);
+		}
+
+		m_CullSuspended--;
+
+		return true;
+	}
+
+	bool SpriteRecorder::DrawSolidTriangle(const Vector2 p_Positions[3], const Color& p_Color, float p_Depth)
+	{
+		Color colors[3] = {
+			p_Color, p_Color, p_Color
+		};
+
+		return DrawSolidTriangle(p_Positions, colors, p_Depth);
+	}
+	
+	bool SpriteRecorder::DrawSolidTriangle(const Vector2 p_Positions[3], const Color p_Colors[3], float p_Depth)
+	{
+		if (!Accept(std::min(std::min(p_Positions[0].X, p_Positions[1].X), p_Positions[2].X),
+					std::min(std::min(p_Positions[0].Y, p_Positions[1].Y), p_Positions[2].Y),
+					std::max(std::max(p_Positions[0].X, p_Positions[1].X), p_Positions[2].X),
+					std::max(std::max(p_Positions[0].Y, p_Positions[1].Y), p_Positions[2].Y)))
+			return true;
+
+		SpriteBatchItem& item = GetNextItem(m_BlankTextureID, p_Depth);
+
+		// Top left vertex.
+		SetVertex(item.VertexA,
+			p_Positions[0].X, p_Positions[0].Y,
+			p_Colors[0],
+			0.0f, 0.0f);
+
+		// Top right vertex.
+		SetVertex(item.VertexB,
+			p_Positions[1].X, p_Positions[1].Y,
+			p_Colors[1],
+			0.0f, 0.0f);
+
+		// Bottom left vertex.
+		SetVertex(item.VertexC,
+			p_Positions[2].X, p_Positions[2].Y,
+			p_Colors[2],
+			0.0f, 0.0f);
+
+		// Repeat the last vertex so the quad's second triangle is degenerate.
+		item.VertexD = item.VertexC;
+
+		return true;
+	}
+
+	bool SpriteRecorder::DrawSolidRectangle(float p_X, float p_Y, float p_Width, float p_Height, const Color& p_Color, float p_Depth)
+	{
+		if (!Accept(std::min(p_X, p_X + p_Width), std::min(p_Y, p_Y + p_Height), std::max(p_X, p_X + p_Width), std::max(p_Y, p_Y + p_Height)))
+			return true;
+
+		SpriteBatchItem& item = GetNextItem(m_BlankTextureID, p_Depth);
+
+		// Top left vertex.
+		SetVertex(item.VertexA,
+			p_X, p_Y,
+			p_Color,
+			0.0f, 1.0f);
+
+		// Bottom left vertex.
+		SetVertex(item.VertexB,
+			p_X, p_Y + p_Height,
+			p_Color,
+			0.0f, 0.0f);
+
+		// Top right vertex.
+		SetVertex(item.VertexC,
+			p_X + p_Width, p_Y,
+			p_Color,
+			1.0f, 1.0f);
+
+		// Bottom right vertex.
+		SetVertex(item.VertexD,
+			p_X + p_Width, p_Y + p_Height,
+			p_Color,
+			1.0f, 0.0f);
+
+		return true;
+	}
+
+	bool SpriteRecorder::DrawSolidRectangle(const Rectangle& p_Rectangle, const Color& p_Color, float p_Depth)
+	{
+		return DrawSolidRectangle(static_cast<float>(p_Rectangle.X),
+								  static_cast<float>(p_Rectangle.Y),
+								  static_cast<float>(p_Rectangle.Width),
+								  static_cast<float>(p_Rectangle.Height),
+								  p_Color, p_Depth);
+	}
+
+	bool SpriteRecorder::DrawSolidRectangle(const Vector2& p_Position, const Vector2& p_Dimensions, const Color& p_Color, float p_Depth)
+	{
+		return DrawSolidRectangle(p_Position.X, p_Position.Y, p_Dimensions.X, p_Dimensions.Y, p_Color, p_Depth);
+	}
+
+	bool SpriteRecorder::DrawSolidCircle(const Vector2& p_Position, const Color& p_Color, float p_Radius, float p_Depth, const UnitCircle& p_Circle)
+	{
+		return DrawSolidCircle(p_Position, p_Color, p_Color, p_Radius, p_Depth, p_Circle);
+	}
+
+	bool SpriteRecorder::DrawSolidCircle(const Vector2& p_Position, const Color& p_ColorA, const Color& p_ColorB, float p_Radius, float p_Depth, const UnitCircle& p_Circle)
+	{
+		if (!Accept(p_Position.X - p_Radius, p_Position.Y - p_Radius, p_Position.X + p_Radius, p_Position.Y + p_Radius))
+			return true;
+
+		Vector2 positions[3];
+		positions[1] = p_Position;
+
+		Color colors[3] = {
+			p_ColorB,
+			p_ColorA,
+			p_ColorB
+		};
+
+		const Vector2* points = p_Circle.GetPoints();
+		int segmentCount = p_Circle.GetSegmentCount();
+
+		m_CullSuspended++;
+
+		for (int i = 0; i < segmentCount; ++i)
+		{
+			positions[0].X = p_Position.X + p_Radius * points[i].X;
+			positions[0].Y = p_Position.Y + p_Radius * points[i].Y;
+
+			positions[2].X = p_Position.X + p_Radius * points[i + 1].X;
+			positions[2].Y = p_Position.Y + p_Radius * points[i + 1].Y;
+
+			DrawSolidTriangle(positions, colors, p_Depth);
+		}
+
+		m_CullSuspended--;
+
+		return true;
+	}
+
+	bool SpriteRecorder::DrawSprite(const Texture& p_Texture, const Vector2& p_Position, const Vector2& p_Dimensions, const Rectangle& p_SourceRectangle, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth)
+	{
+		// TODO: Factor in p_Dimensions.
+		return DrawSprite(p_Texture, p_Position, p_SourceRectangle, p_Color, p_Origin, p_Rotation, p_Scale, p_Orientation, p_Depth);
+	}
+
+	bool SpriteRecorder::DrawSprite(const Texture& p_Texture, const Vector2& p_Position, const Rectangle& p_DestinationRectangle, const Rectangle& p_SourceRectangle, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth)
+	{
+		// TODO: Factor in p_DestinationRectangle.
+		return DrawSprite(p_Texture, p_Position, p_SourceRectangle, p_Color, p_Origin, p_Rotation, p_Scale, p_Orientation, p_Depth);
+	}
+
+	bool SpriteRecorder::DrawSprite(const Texture& p_Texture, const Rectangle& p_DestinationRectangle, const Rectangle& p_SourceRectangle, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth)
+	{
+		// TODO: Factor in p_DestinationRectangle BETTERLY.
+		return DrawSprite(p_Texture, Vector2(p_DestinationRectangle.X, p_DestinationRectangle.Y), p_SourceRectangle, p_Color, p_Origin, p_Rotation, p_Scale, p_Orientation, p_Depth);
+	}
+
+	bool SpriteRecorder::DrawSprite(const Texture& p_Texture, const Vector2& p_Position, const Rectangle& p_SourceRectangle, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth)
+	{
+		float textureWidth = static_cast<float>(p_Texture.GetWidth());
+		float textureHeight = static_cast<float>(p_Texture.GetHeight());
+
+		float correctionX = 1.0f / textureWidth;
+		float correctionY = 1.0f / textureHeight;
+
+		Rectangle textureBounds;
+		if (p_SourceRectangle != Rectangle::Empty)
+			textureBounds = p_SourceRectangle;
+		else
+			textureBounds = Rectangle(0, 0, textureWidth, textureHeight);
+
+		float sizeX = textureBounds.Width * p_Scale.X;
+		float sizeY = textureBounds.Height * p_Scale.Y;
+
+		float originX = -p_Origin.X * p_Scale.X;
+		float originY = -p_Origin.Y * p_Scale.Y;
+
+		// Flips only swap texture coordinates, so rotation is the only transform that moves the quad.
+		if (!AcceptAbout(p_Position, originX, originY, originX + sizeX, originY + sizeY, p_Rotation != 0.0f))
+			return true;
+
+		float texCoordTop = textureBounds.Y / textureHeight + correctionY;
+		float texCoordBottom = (textureBounds.Y + textureBounds.Height) / textureHeight - correctionY;
+		float texCoordLeft = textureBounds.X / textureWidth + correctionX;
+		float texCoordRight = (textureBounds.X + textureBounds.Width) / textureWidth - correctionX;
+
+		// Record a single instance and let the vertex shader expand it.
+		if (m_Instancing)
+		{
+			VertexSpriteInstance& instance = GetNextInstance(p_Texture.GetID(), p_Depth);
+
+			instance.Position.X = p_Position.X;
+			instance.Position.Y = p_Position.Y;
+			instance.Size.X = sizeX;
+			instance.Size.Y = sizeY;
+			instance.Origin.X = -originX;
+			instance.Origin.Y = -originY;
+			instance.Rotation = p_Rotation;
+			PackTexCoord(instance.TexCoordMin, texCoordLeft, texCoordTop);
+			PackTexCoord(instance.TexCoordMax, texCoordRight, texCoordBottom);
+			PackColor(instance.Color, p_Color.GetRed(), p_Color.GetGreen(), p_Color.GetBlue(), p_Color.GetAlpha());
+			instance.Flags = static_cast<unsigned int>(p_Orientation);
+
+			return true;
+		}
+
+		// Calculate cos/sin for rotation in radians.
+		float cosAngle = cosf(p_Rotation);
+		float sinAngle = sinf(p_Rotation);
+
+		// Flip texture coordinates for orientation.
+		if ((p_Orientation & Orientation::FlipHorizontal) == Orientation::FlipHorizontal)
+			std::swap(texCoordLeft, texCoordRight);
+		if ((p_Orientation & Orientation::FlipVertical) == Orientation::FlipVertical)
+			std::swap(texCoordTop, texCoordBottom);
+
+		SpriteBatchItem& item = GetNextItem(p_Texture.GetID(), p_Depth);
+
+		// Top left vertex.
+		SetVertex(item.VertexA,
+			p_Position.X + originX * cosAngle - originY * sinAngle,
+			p_Position.Y + originX * sinAngle + originY * cosAngle,
+			p_Color,
+			texCoordLeft, texCoordTop);
+
+		// Bottom left vertex.
+		SetVertex(item.VertexB,
+			p_Position.X + originX * cosAngle - (originY + sizeY) * sinAngle,
+			p_Position.Y + originX * sinAngle + (originY + sizeY) * cosAngle,
+			p_Color,
+			texCoordLeft, texCoordBottom);
+
+		// Top right vertex.
+		SetVertex(item.VertexC,
+			p_Position.X + (originX + sizeX) * cosAngle - originY * sinAngle,
+			p_Position.Y + (originX + sizeX) * sinAngle + originY * cosAngle,
+			p_Color,
+			texCoordRight, texCoordTop);
+
+		// Bottom right vertex.
+		SetVertex(item.VertexD,
+			p_Position.X + (originX + sizeX) * cosAngle - (originY + sizeY) * sinAngle,
+			p_Position.Y + (originX + sizeX) * sinAngle + (originY + sizeY) * cosAngle,
+			p_Color,
+			texCoordRight, texCoordBottom);
+
+		return true;
+	}
+
+	bool SpriteRecorder::DrawSprites(const Texture& p_Texture, const SpriteDescriptors& p_Sprites)
+	{
+		if (p_Sprites.Count > 0 && (p_Sprites.PositionX == nullptr || p_Sprites.PositionY == nullptr))
+		{
+			SDL_Log("[SpriteRecorder::DrawSprites] Sprite positions are required.");
+			return false;
+		}
+
+		int first = 0;
+
+		// Instances are already a single record per sprite, so only quads go through the wide path.
+#if defined __SSE2__ || defined _M_X64
+		if (!m_Instancing)
+		{
+			for (; first + 4 <= p_Sprites.Count; first += 4)
+			{
+				DrawSpritesSSE(p_Texture, p_Sprites, first);
+			}
+		}
+#endif
+
+		for (int i = first; i < p_Sprites.Count; ++i)
+		{
+			DrawSpriteAt(p_Texture, p_Sprites, i);
+		}
+
+		return true;
+	}
+
+	bool SpriteRecorder::DrawSpriteAt(const Texture& p_Texture, const SpriteDescriptors& p_Sprites, int p_Index)
+	{
+		Vector2 position(p_Sprites.PositionX[p_Index], p_Sprites.PositionY[p_Index]);
+		Vector2 origin(p_Sprites.OriginX != nullptr ? p_Sprites.OriginX[p_Index] : 0.0f, p_Sprites.OriginY != nullptr ? p_Sprites.OriginY[p_Index] : 0.0f);
+		Vector2 scale(p_Sprites.ScaleX != nullptr ? p_Sprites.ScaleX[p_Index] : 1.0f, p_Sprites.ScaleY != nullptr ? p_Sprites.ScaleY[p_Index] : 1.0f);
+
+		return DrawSprite(p_Texture, position,
+			p_Sprites.SourceRectangles != nullptr ? p_Sprites.SourceRectangles[p_Index] : Rectangle::Empty,
+			p_Sprites.Colors != nullptr ? p_Sprites.Colors[p_Index] : Color::White,
+			origin,
+			p_Sprites.Rotation != nullptr ? p_Sprites.Rotation[p_Index] : 0.0f,
+			scale,
+			p_Sprites.Orientations != nullptr ? p_Sprites.Orientations[p_Index] : Orientation::None,
+			p_Sprites.Depth != nullptr ? p_Sprites.Depth[p_Index] : 0.0f);
+	}
+
+#if defined __SSE2__ || defined _M_X64
+	void SpriteRecorder::DrawSpritesSSE(const Texture& p_Texture, const SpriteDescriptors& p_Sprites, int p_First)
+	{
+		// Four sprites at a time. Every operation mirrors DrawSprite in the same order so the
+		// results are bit-identical; rotation uses the same scalar cosf/sinf.
+		float textureWidth = static_cast<float>(p_Texture.GetWidth());
+		float textureHeight = static_cast<float>(p_Texture.GetHeight());
+
+		float sourceLeft[4], sourceTop[4], sourceRight[4], sourceBottom[4], sourceWidth[4], sourceHeight[4];
+		float cosAngle[4], sinAngle[4];
+		bool rotated[4];
+		int flipHorizontal[4], flipVertical[4];
+
+		for (int k = 0; k < 4; ++k)
+		{
+			int i = p_First + k;
+
+			Rectangle textureBounds;
+			if (p_Sprites.SourceRectangles != nullptr && p_Sprites.SourceRectangles[i] != Rectangle::Empty)
+				textureBounds = p_Sprites.SourceRectangles[i];
+			else
+				textureBounds = Rectangle(0, 0, textureWidth, textureHeight);
+
+			sourceLeft[k] = static_cast<float>(textureBounds.X);
+			sourceTop[k] = static_cast<float>(textureBounds.Y);
+			sourceRight[k] = static_cast<float>(textureBounds.X + textureBounds.Width);
+			sourceBottom[k] = static_cast<float>(textureBounds.Y + textureBounds.Height);
+			sourceWidth[k] = static_cast<float>(textureBounds.Width);
+			sourceHeight[k] = static_cast<float>(textureBounds.Height);
+
+			float rotation = p_Sprites.Rotation != nullptr ? p_Sprites.Rotation[i] : 0.0f;
+			cosAngle[k] = cosf(rotation);
+			sinAngle[k] = sinf(rotation);
+			rotated[k] = rotation != 0.0f;
+
+			Orientation orientation = p_Sprites.Orientations != nullptr ? p_Sprites.Orientations[i] : Orientation::None;
+			flipHorizontal[k] = (orientation & Orientation::FlipHorizontal) == Orientation::FlipHorizontal ? -1 : 0;
+			flipVertical[k] = (orientation & Orientation::FlipVertical) == Orientation::FlipVertical ? -1 : 0;
+		}
+
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 signBit = _mm_set1_ps(-0.0f);
+
+		__m128 positionX = _mm_loadu_ps(p_Sprites.PositionX + p_First);
+		__m128 positionY = _mm_loadu_ps(p_Sprites.PositionY + p_First);
+		__m128 scaleX = p_Sprites.ScaleX != nullptr ? _mm_loadu_ps(p_Sprites.ScaleX + p_First) : one;
+		__m128 scaleY = p_Sprites.ScaleY != nullptr ? _mm_loadu_ps(p_Sprites.ScaleY + p_First) : one;
+		__m128 originX = p_Sprites.OriginX != nullptr ? _mm_loadu_ps(p_Sprites.OriginX + p_First) : zero;
+		__m128 originY = p_Sprites.OriginY != nullptr ? _mm_loadu_ps(p_Sprites.OriginY + p_First) : zero;
+		__m128 cosine = _mm_loadu_ps(cosAngle);
+		__m128 sine = _mm_loadu_ps(sinAngle);
+
+		// Size and origin in screen space.
+		__m128 sizeX = _mm_mul_ps(_mm_loadu_ps(sourceWidth), scaleX);
+		__m128 sizeY = _mm_mul_ps(_mm_loadu_ps(sourceHeight), scaleY);
+		originX = _mm_mul_ps(_mm_xor_ps(originX, signBit), scaleX);
+		originY = _mm_mul_ps(_mm_xor_ps(originY, signBit), scaleY);
+
+		// Texture coordinates, inset by one texel.
+		__m128 width = _mm_set1_ps(textureWidth);
+		__m128 height = _mm_set1_ps(textureHeight);
+		__m128 correctionX = _mm_set1_ps(1.0f / textureWidth);
+		__m128 correctionY = _mm_set1_ps(1.0f / textureHeight);
+
+		__m128 texCoordTop = _mm_add_ps(_mm_div_ps(_mm_loadu_ps(sourceTop), height), correctionY);
+		__m128 texCoordBottom = _mm_sub_ps(_mm_div_ps(_mm_loadu_ps(sourceBottom), height), correctionY);
+		__m128 texCoordLeft = _mm_add_ps(_mm_div_ps(_mm_loadu_ps(sourceLeft), width), correctionX);
+		__m128 texCoordRight = _mm_sub_ps(_mm_div_ps(_mm_loadu_ps(sourceRight), width), correctionX);
+
+		// Flip texture coordinates for orientation.
+		__m128 maskHorizontal = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(flipHorizontal)));
+		__m128 maskVertical = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(flipVertical)));
+
+		__m128 left = _mm_or_ps(_mm_and_ps(maskHorizontal, texCoordRight), _mm_andnot_ps(maskHorizontal, texCoordLeft));
+		__m128 right = _mm_or_ps(_mm_and_ps(maskHorizontal, texCoordLeft), _mm_andnot_ps(maskHorizontal, texCoordRight));
+		__m128 top = _mm_or_ps(_mm_and_ps(maskVertical, texCoordBottom), _mm_andnot_ps(maskVertical, texCoordTop));
+		__m128 bottom = _mm_or_ps(_mm_and_ps(maskVertical, texCoordTop), _mm_andnot_ps(maskVertical, texCoordBottom));
+
+		// Rotated corner offsets.
+		__m128 farX = _mm_add_ps(originX, sizeX);
+		__m128 farY = _mm_add_ps(originY, sizeY);
+
+		__m128 nearXCos = _mm_mul_ps(originX, cosine);
+		__m128 nearXSin = _mm_mul_ps(originX, sine);
+		__m128 nearYCos = _mm_mul_ps(originY, cosine);
+		__m128 nearYSin = _mm_mul_ps(originY, sine);
+		__m128 farXCos = _mm_mul_ps(farX, cosine);
+		__m128 farXSin = _mm_mul_ps(farX, sine);
+		__m128 farYCos = _mm_mul_ps(farY, cosine);
+		__m128 farYSin = _mm_mul_ps(farY, sine);
+
+		float vertexX[4][4], vertexY[4][4], texCoordU[2][4], texCoordV[2][4];
+		float nearX[4], nearY[4], farCornerX[4], farCornerY[4];
+
+		_mm_storeu_ps(nearX, originX);
+		_mm_storeu_ps(nearY, originY);
+		_mm_storeu_ps(farCornerX, farX);
+		_mm_storeu_ps(farCornerY, farY);
+
+		// Top left, bottom left, top right, bottom right.
+		_mm_storeu_ps(vertexX[0], _mm_sub_ps(_mm_add_ps(positionX, nearXCos), nearYSin));
+		_mm_storeu_ps(vertexY[0], _mm_add_ps(_mm_add_ps(positionY, nearXSin), nearYCos));
+		_mm_storeu_ps(vertexX[1], _mm_sub_ps(_mm_add_ps(positionX, nearXCos), farYSin));
+		_mm_storeu_ps(vertexY[1], _mm_add_ps(_mm_add_ps(positionY, nearXSin), farYCos));
+		_mm_storeu_ps(vertexX[2], _mm_sub_ps(_mm_add_ps(positionX, farXCos), nearYSin));
+		_mm_storeu_ps(vertexY[2], _mm_add_ps(_mm_add_ps(positionY, farXSin), nearYCos));
+		_mm_storeu_ps(vertexX[3], _mm_sub_ps(_mm_add_ps(positionX, farXCos), farYSin));
+		_mm_storeu_ps(vertexY[3], _mm_add_ps(_mm_add_ps(positionY, farXSin), farYCos));
+		_mm_storeu_ps(texCoordU[0], left);
+		_mm_storeu_ps(texCoordU[1], right);
+		_mm_storeu_ps(texCoordV[0], top);
+		_mm_storeu_ps(texCoordV[1], bottom);
+
+		unsigned int textureID = p_Texture.GetID();
+
+		for (int k = 0; k < 4; ++k)
+		{
+			int i = p_First + k;
+
+			// Same bounds as DrawSprite, so culling agrees with the scalar path.
+			if (!AcceptAbout(Vector2(p_Sprites.PositionX[i], p_Sprites.PositionY[i]), nearX[k], nearY[k], farCornerX[k], farCornerY[k], rotated[k]))
+				continue;
+
+			const Color& color = p_Sprites.Colors != nullptr ? p_Sprites.Colors[i] : Color::White;
+			SpriteBatchItem& item = GetNextItem(textureID, p_Sprites.Depth != nullptr ? p_Sprites.Depth[i] : 0.0f);
+
+			SetVertex(item.VertexA, vertexX[0][k], vertexY[0][k], color, texCoordU[0][k], texCoordV[0][k]);
+			SetVertex(item.VertexB, vertexX[1][k], vertexY[1][k], color, texCoordU[0][k], texCoordV[1][k]);
+			SetVertex(item.VertexC, vertexX[2][k], vertexY[2][k], color, texCoordU[1][k], texCoordV[0][k]);
+			SetVertex(item.VertexD, vertexX[3][k], vertexY[3][k], color, texCoordU[1][k], texCoordV[1][k]);
+		}
+	}
+#endif
+
+	bool SpriteRecorder::DrawString(const SAGE::IFont* const p_Font, const std::string& p_String, const Vector2& p_Position, const Color& p_Color, float p_Depth)
+	{
+		return DrawString(p_Font, p_String, p_Position, p_Color, Vector2::Zero, 0.0f, Vector2::One, SAGE::Orientation::None, p_Depth);
+	}
+
+	bool SpriteRecorder::DrawString(const SAGE::IFont* const p_Font, const std::string& p_String, const Vector2& p_Position, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth)
+	{
+		// Cached strings are laid out once about the origin and only translated and recolored here.
+		if (m_TextCaching)
+		{
+			const TextMesh& mesh = GetTextMesh(p_Font, p_String, p_Origin, p_Rotation, p_Scale, p_Orientation);
+
+			if (!Accept(p_Position.X + mesh.Minimum.X, p_Position.Y + mesh.Minimum.Y, p_Position.X + mesh.Maximum.X, p_Position.Y + mesh.Maximum.Y))
+				return true;
+
+			for (const SpriteBatchItem& quad : mesh.Quads)
+			{
+				SpriteBatchItem& item = GetNextItem(mesh.TextureID, p_Depth);
+
+				SetVertex(item.VertexA, quad.VertexA.Position.X + p_Position.X, quad.VertexA.Position.Y + p_Position.Y, p_Color, quad.VertexA.TexCoord.X, quad.VertexA.TexCoord.Y);
+				SetVertex(item.VertexB, quad.VertexB.Position.X + p_Position.X, quad.VertexB.Position.Y + p_Position.Y, p_Color, quad.VertexB.TexCoord.X, quad.VertexB.TexCoord.Y);
+				SetVertex(item.VertexC, quad.VertexC.Position.X + p_Position.X, quad.VertexC.Position.Y + p_Position.Y, p_Color, quad.VertexC.TexCoord.X, quad.VertexC.TexCoord.Y);
+				SetVertex(item.VertexD, quad.VertexD.Position.X + p_Position.X, quad.VertexD.Position.Y + p_Position.Y, p_Color, quad.VertexD.TexCoord.X, quad.VertexD.TexCoord.Y);
+			}
+
+			return true;
+		}
+
+		float lineSpacing = p_Font->GetLineSpacing();
+
+		float originX = -p_Origin.X * p_Scale.X;
+		float originY = -p_Origin.Y * p_Scale.Y;
+
+		std::vector<std::string> lines;
+		String::Split(p_String, "\n", lines);
+
+		// Measure the whole run so an off-screen string is rejected before any glyph is built.
+		if (m_Culling && m_CullSuspended == 0)
+		{
+			float offsetX = 0.0f;
+			float offsetY = 0.0f;
+			float extentX = 0.0f;
+			float extentY = 0.0f;
+
+			for (const std::string& line : lines)
+			{
+				for (char character : line)
+				{
+					Rectangle textureBounds = p_Font->GetCharacterBounds(character);
+
+					extentX = std::max(extentX, offsetX + textureBounds.Width * p_Scale.X);
+					extentY = std::max(extentY, offsetY + textureBounds.Height * p_Scale.Y);
+
+					offsetX += p_Font->GetCharacterSpacing(character) * p_Scale.X;
+				}
+
+				offsetX = 0.0f;
+				offsetY += lineSpacing * p_Scale.Y;
+			}
+
+			bool transformed = p_Rotation != 0.0f || p_Orientation != Orientation::None;
+			if (!AcceptAbout(p_Position, originX, originY, originX + extentX, originY + extentY, transformed))
+				return true;
+		}
+		else if (!Accept(p_Position.X, p_Position.Y, p_Position.X, p_Position.Y))
+		{
+			return true;
+		}
+
+		LayoutString(p_Font, lines, p_Position, p_Color, p_Origin, p_Rotation, p_Scale, p_Orientation, p_Depth, nullptr);
+
+		return true;
+	}
+
+	void SpriteRecorder::LayoutString(const SAGE::IFont* const p_Font, const std::vector<std::string>& p_Lines, const Vector2& p_Position, const Color& p_Color, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation, float p_Depth, std::vector<SpriteBatchItem>* p_Quads)
+	{
+		const Texture& texture = p_Font->GetTexture();
+
+		float textureWidth = static_cast<float>(texture.GetWidth());
+		float textureHeight = static_cast<float>(texture.GetHeight());
+
+		float lineSpacing = p_Font->GetLineSpacing();
+
+		float correctionX = 1.0f / textureWidth;
+		float correctionY = 1.0f / textureHeight;
+
+		float originX = -p_Origin.X * p_Scale.X;
+		float originY = -p_Origin.Y * p_Scale.Y;
+
+		float cosAngle = cosf(p_Rotation);
+		float sinAngle = sinf(p_Rotation);
+
+		float offsetX = 0.0f;
+		float offsetY = 0.0f;
+
+		SpriteBatchItem quad;
+
+		for (const std::string& line : p_Lines)
+		{
+			for (char character : line)
+			{
+				Rectangle textureBounds = p_Font->GetCharacterBounds(character);
+
+				float sizeX = textureBounds.Width * p_Scale.X;
+				float sizeY = textureBounds.Height * p_Scale.Y;
+
+				float texCoordTop = textureBounds.Y / textureHeight + correctionY;
+				float texCoordBottom = (textureBounds.Y + textureBounds.Height) / textureHeight - correctionY;
+				float texCoordLeft = textureBounds.X / textureWidth + correctionX;
+				float texCoordRight = (textureBounds.X + textureBounds.Width) / textureWidth - correctionX;
+
+				// Meshes collect quads for later; otherwise they're written straight into the recorder.
+				SpriteBatchItem& item = p_Quads != nullptr ? quad : GetNextItem(texture.GetID(), p_Depth);
+
+				// Top left vertex.
+				SetVertex(item.VertexA,
+					p_Position.X + originX + offsetX, p_Position.Y + originY + offsetY,
+					p_Color,
+					texCoordLeft, texCoordTop);
+
+				// Bottom left vertex.
+				SetVertex(item.VertexB,
+					p_Position.X + originX + offsetX, p_Position.Y + originY + sizeY + offsetY,
+					p_Color,
+					texCoordLeft, texCoordBottom);
+
+				// Top right vertex.
+				SetVertex(item.VertexC,
+					p_Position.X + originX + sizeX + offsetX, p_Position.Y + originY + offsetY,
+					p_Color,
+					texCoordRight, texCoordTop);
+
+				// Bottom right vertex.
+				SetVertex(item.VertexD,
+					p_Position.X + originX + sizeX + offsetX, p_Position.Y + originY + sizeY + offsetY,
+					p_Color,
+					texCoordRight, texCoordBottom);
+
+				TransformVerticesAbout(item, p_Position, cosAngle, sinAngle, p_Orientation);
+
+				if (p_Quads != nullptr)
+					p_Quads->push_back(quad);
+
+				offsetX += p_Font->GetCharacterSpacing(character) * p_Scale.X;
+			}
+
+			offsetX = 0.0f;
+			offsetY += lineSpacing * p_Scale.Y;
+		}
+	}
+
+	const TextMesh& SpriteRecorder::GetTextMesh(const SAGE::IFont* const p_Font, const std::string& p_String, const Vector2& p_Origin, float p_Rotation, const Vector2& p_Scale, Orientation p_Orientation)
+	{
+		unsigned int textureID = p_Font->GetTexture().GetID();
+
+		// Mix everything that changes the layout into one hash; full keys are compared on lookup.
+		size_t hash = std::hash<std::string>()(p_String);
+		hash ^= std::hash<const void*>()(p_Font) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+		hash ^= std::hash<float>()(p_Origin.X) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+		hash ^= std::hash<float>()(p_Origin.Y) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+		hash ^= std::hash<float>()(p_Rotation) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+		hash ^= std::hash<float>()(p_Scale.X) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+		hash ^= std::hash<float>()(p_Scale.Y) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+		hash ^= static_cast<size_t>(p_Orientation) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+
+		auto range = m_TextMeshes.equal_range(hash);
+		for (auto iterator = range.first; iterator != range.second; ++iterator)
+		{
+			TextMesh& mesh = iterator->second;
+
+			if (mesh.Font == p_Font && mesh.Text == p_String &&
+				mesh.Origin.X == p_Origin.X && mesh.Origin.Y == p_Origin.Y && mesh.Rotation == p_Rotation &&
+				mesh.Scale.X == p_Scale.X && mesh.Scale.Y == p_Scale.Y && mesh.Flip == p_Orientation)
+			{
+				// A font that reloaded its texture needs a fresh layout.
+				if (mesh.TextureID != textureID)
+				{
+					m_TextMeshes.erase(iterator);
+					break;
+				}
+
+				mesh.LastUsedFrame = m_FrameIndex;
+				return mesh;
+			}
+		}
+
+		// A full cache makes room by dropping the string drawn least recently.
+		if ((int)m_TextMeshes.size() >= MaxTextMeshCount)
+		{
+			auto oldest = m_TextMeshes.begin();
+			for (auto iterator = m_TextMeshes.begin(); iterator != m_TextMeshes.end(); ++iterator)
+			{
+				if (iterator->second.LastUsedFrame < oldest->second.LastUsedFrame)
+					oldest = iterator;
+			}
+
+			m_TextMeshes.erase(oldest);
+		}
+
+		TextMesh& mesh = m_TextMeshes.emplace(hash, TextMesh())->second;
+		mesh.Font = p_Font;
+		mesh.TextureID = textureID;
+		mesh.Text = p_String;
+		mesh.Origin = p_Origin;
+		mesh.Rotation = p_Rotation;
+		mesh.Scale = p_Scale;
+		mesh.Flip = p_Orientation;
+		mesh.LastUsedFrame = m_FrameIndex;
+
+		std::vector<std::string> lines;
+		String::Split(p_String, "\n", lines);
+
+		LayoutString(p_Font, lines, Vector2::Zero, Color::White, p_Origin, p_Rotation, p_Scale, p_Orientation, 0.0f, &mesh.Quads);
+
+		// Bounds of every laid out vertex, used for culling the whole string at once.
+		mesh.Minimum = Vector2::Zero;
+		mesh.Maximum = Vector2::Zero;
+
+		for (size_t i = 0; i < mesh.Quads.size(); ++i)
+		{
+			const VertexPositionColorTexture* vertices[4] = { &mesh.Quads[i].VertexA, &mesh.Quads[i].VertexB, &mesh.Quads[i].VertexC, &mesh.Quads[i].VertexD };
+
+			for (int j = 0; j < 4; ++j)
+			{
+				if (i == 0 && j == 0)
+				{
+					mesh.Minimum = Vector2(vertices[j]->Position.X, vertices[j]->Position.Y);
+					mesh.Maximum = mesh.Minimum;
+					continue;
+				}
+
+				mesh.Minimum.X = std::min(mesh.Minimum.X, vertices[j]->Position.X);
+				mesh.Minimum.Y = std::min(mesh.Minimum.Y, vertices[j]->Position.Y);
+				mesh.Maximum.X = std::max(mesh.Maximum.X, vertices[j]->Position.X);
+				mesh.Maximum.Y = std::max(mesh.Maximum.Y, vertices[j]->Position.Y);
+			}
+		}
+
+		return mesh;
+	}
+
+	void SpriteRecorder::EvictTextMeshes()
+	{
+		for (auto iterator = m_TextMeshes.begin(); iterator != m_TextMeshes.end();)
+		{
+			if (m_FrameIndex - iterator->second.LastUsedFrame > TextMeshLifetime)
+				iterator = m_TextMeshes.erase(iterator);
+			else
+				++iterator;
+		}
+	}
+
+	bool SpriteRecorder::Accept(float p_MinimumX, float p_MinimumY, float p_MaximumX, float p_MaximumY)
+	{
+		// Parts of an already accepted primitive aren't counted on their own.
+		if (m_CullSuspended > 0)
+			return true;
+
+		if (m_Culling && (p_MaximumX < m_CullMinimum.X || p_MinimumX > m_CullMaximum.X ||
+						  p_MaximumY < m_CullMinimum.Y || p_MinimumY > m_CullMaximum.Y))
+		{
+			m_CulledCount++;
+			return false;
+		}
+
+		m_SubmittedCount++;
+		return true;
+	}
+
+	bool SpriteRecorder::AcceptAbout(const Vector2& p_Position, float p_MinimumX, float p_MinimumY, float p_MaximumX, float p_MaximumY, bool p_Transformed)
+	{
+		if (!p_Transformed)
+			return Accept(p_Position.X + p_MinimumX, p_Position.Y + p_MinimumY, p_Position.X + p_MaximumX, p_Position.Y + p_MaximumY);
+
+		// Rotating or flipping about the position keeps every corner within the farthest corner's distance.
+		float farX = std::max(p_MinimumX * p_MinimumX, p_MaximumX * p_MaximumX);
+		float farY = std::max(p_MinimumY * p_MinimumY, p_MaximumY * p_MaximumY);
+		float radius = sqrtf(farX + farY);
+
+		return Accept(p_Position.X - radius, p_Position.Y - radius, p_Position.X + radius, p_Position.Y + radius);
+	}
+
+	SpriteBatchItem& SpriteRecorder::GetNextItem(unsigned int p_TextureID, float p_Depth)
+	{
+		// Grow by whole pages so items already handed out never move.
+		if (m_ItemCount == (int)m_ItemPages.size() * ItemPageSize)
+		{
+			m_ItemPages.push_back(std::vector<SpriteBatchItem>(ItemPageSize));
+		}
+
+		SpriteBatchItem& item = m_ItemPages[m_ItemCount / ItemPageSize][m_ItemCount % ItemPageSize];
+		m_ItemCount++;
+		item.TextureID = p_TextureID;
+		item.Depth = p_Depth;
+		item.InstanceIndex = -1;
+
+		return item;
+	}
+
+	VertexSpriteInstance& SpriteRecorder::GetNextInstance(unsigned int p_TextureID, float p_Depth)
+	{
+		SpriteBatchItem& item = GetNextItem(p_TextureID, p_Depth);
+		item.InstanceIndex = m_InstanceCount;
+
+		if (m_InstanceCount == (int)m_InstanceList.size())
+		{
+			m_InstanceList.resize(std::max(m_InstanceList.size() * 2, static_cast<size_t>(ItemPageSize)));
+		}
+
+		return m_InstanceList[m_InstanceCount++];
+	}
+
+	void SpriteRecorder::SetVertexPosition(VertexPositionColorTexture& p_Vertex, float p_X, float p_Y)
+	{
+		p_Vertex.Position.X = p_X;
+		p_Vertex.Position.Y = p_Y;
+	}
+
+	void SpriteRecorder::SetVertexColor(VertexPositionColorTexture& p_Vertex, const Color& p_Color)
+	{
+		p_Vertex.Color.R = p_Color.GetRed();
+		p_Vertex.Color.G = p_Color.GetGreen();
+		p_Vertex.Color.B = p_Color.GetBlue();
+		p_Vertex.Color.A = p_Color.GetAlpha();
+	}
+
+	void SpriteRecorder::SetVertexTexCoords(VertexPositionColorTexture& p_Vertex, float p_U, float p_V)
+	{
+		p_Vertex.TexCoord.X = p_U;
+		p_Vertex.TexCoord.Y = p_V;
+	}
+
+	void SpriteRecorder::SetVertex(VertexPositionColorTexture& p_Vertex, float p_X, float p_Y, const Color& p_Color, float p_U, float p_V)
+	{
+		SetVertexPosition(p_Vertex, p_X, p_Y);
+		SetVertexColor(p_Vertex, p_Color);
+		SetVertexTexCoords(p_Vertex, p_U, p_V);
+	}
+
+	void SpriteRecorder::PackColor(VertexColorPacked& p_Packed, float p_Red, float p_Green, float p_Blue, float p_Alpha)
+	{
+		p_Packed.R = static_cast<unsigned char>(Math::Clamp(p_Red, 0.0f, 1.0f) * 255.0f + 0.5f);
+		p_Packed.G = static_cast<unsigned char>(Math::Clamp(p_Green, 0.0f, 1.0f) * 255.0f + 0.5f);
+		p_Packed.B = static_cast<unsigned char>(Math::Clamp(p_Blue, 0.0f, 1.0f) * 255.0f + 0.5f);
+		p_Packed.A = static_cast<unsigned char>(Math::Clamp(p_Alpha, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+
+	void SpriteRecorder::PackTexCoord(VertexTexCoordPacked& p_Packed, float p_U, float p_V)
+	{
+		p_Packed.U = static_cast<unsigned short>(Math::Clamp(p_U, 0.0f, 1.0f) * 65535.0f + 0.5f);
+		p_Packed.V = static_cast<unsigned short>(Math::Clamp(p_V, 0.0f, 1.0f) * 65535.0f + 0.5f);
+	}
+
+	void SpriteRecorder::TransformVerticesAbout(SpriteBatchItem& p_Item, const Vector2& p_Position, float p_CosAngle, float p_SinAngle, Orientation p_Orientation)
+	{
+		RotateVerticesAbout(p_Item, p_Position, p_CosAngle, p_SinAngle);
+		FlipVerticesAbout(p_Item, p_Position, p_Orientation);
+	}
+
+	void SpriteRecorder::RotateVerticesAbout(SpriteBatchItem& p_Item, const Vector2& p_Position, float p_CosAngle, float p_SinAngle)
+	{
+		RotateVertexAbout(p_Item.VertexA, p_Position, p_CosAngle, p_SinAngle);
+		RotateVertexAbout(p_Item.VertexB, p_Position, p_CosAngle, p_SinAngle);
+		RotateVertexAbout(p_Item.VertexC, p_Position, p_CosAngle, p_SinAngle);
+		RotateVertexAbout(p_Item.VertexD, p_Position, p_CosAngle, p_SinAngle);
+	}
+
+	void SpriteRecorder::FlipVerticesAbout(SpriteBatchItem& p_Item, const Vector2& p_Position, Orientation p_Orientation)
+	{
+		FlipVertexAbout(p_Item.VertexA, p_Position, p_Orientation);
+		FlipVertexAbout(p_Item.VertexB, p_Position, p_Orientation);
+		FlipVertexAbout(p_Item.VertexC, p_Position, p_Orientation);
+		FlipVertexAbout(p_Item.VertexD, p_Position, p_Orientation);
+	}
+
+	void SpriteRecorder::RotateVertexAbout(VertexPositionColorTexture& p_Vertex, const Vector2& p_Position, float p_CosAngle, float p_SinAngle)
+	{
+		// Shift to transform origin.
+		p_Vertex.Position.X -= p_Position.X;
+		p_Vertex.Position.Y -= p_Position.Y;
+
+		// Rotate the vertex about the new origin.
+		float rotationX = p_Vertex.Position.X * p_CosAngle - p_Vertex.Position.Y * p_SinAngle;
+		float rotationY = p_Vertex.Position.X * p_SinAngle + p_Vertex.Position.Y * p_CosAngle;
+
+		// Shift back to the original origin.
+		p_Vertex.Position.X = rotationX + p_Position.X;
+		p_Vertex.Position.Y = rotationY + p_Position.Y;
+	}
+
+	void SpriteRecorder::FlipVertexAbout(VertexPositionColorTexture& p_Vertex, const Vector2& p_Position, Orientation p_Orientation)
+	{
+		// Flip texture vertices horizontally.
+		if ((p_Orientation & Orientation::FlipHorizontal) == Orientation::FlipHorizontal)
+		{
+			p_Vertex.Position.X = p_Position.X - (p_Vertex.Position.X - p_Position.X);
+		}
+
+		// Flip texture vertices vertically.
+		if ((p_Orientation & Orientation::FlipVertical) == Orientation::FlipVertical)
+		{
+			p_Vertex.Position.Y = p_Position.Y - (p_Vertex.Position.Y - p_Position.Y);
+		}
+	}
+}
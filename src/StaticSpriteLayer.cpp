@@ -0,0 +1,253 @@
+// StaticSpriteLayer.cpp
+
+// OpenGL Includes
+#include <GL/glew.h>
+// SAGE Includes
+#include <SAGE/IRenderDevice.hpp>
+#include <SAGE/RenderState.hpp>
+#include <SAGE/StaticSpriteLayer.hpp>
+// STL Includes
+#include <algorithm>
+
+namespace SAGE
+{
+	StaticSpriteLayer::StaticSpriteLayer()
+	{
+		m_IsDirty = false;
+		m_FlushCount = 0;
+		m_VertexArrayObject = 0;
+		m_VertexBufferObject = 0;
+		m_IndexBufferObject = 0;
+	}
+
+	StaticSpriteLayer::~StaticSpriteLayer()
+	{
+		Finalize();
+	}
+
+	int StaticSpriteLayer::GetDrawCallCount() const
+	{
+		return m_FlushCount;
+	}
+
+	int StaticSpriteLayer::GetSpriteCount() const
+	{
+		return m_Recorder.GetItemCount();
+	}
+
+	bool StaticSpriteLayer::IsDirty() const
+	{
+		return m_IsDirty;
+	}
+
+	bool StaticSpriteLayer::Initialize()
+	{
+		GLsizei sizeFloat = sizeof(GLfloat);
+		GLsizei sizeVPCT = sizeof(VertexPositionColorTexture);
+
+		// Create the blank texture used by shapes and lines.
+		std::vector<Color> colors = { Color::White };
+		if (!m_BlankTexture.FromPixelColors(1, 1, colors))
+		{
+			SDL_Log("[StaticSpriteLayer::Initialize] Failed to create 1x1 pixel blank texture.");
+			return false;
+		}
+
+		// Static layers always bake full quads.
+		m_Recorder.Reset(m_BlankTexture.GetID(), false);
+
+		IRenderDevice::Get().GenVertexArrays(1, &m_VertexArrayObject);
+		RenderState::BindVertexArray(m_VertexArrayObject);
+
+		IRenderDevice::Get().GenBuffers(1, &m_IndexBufferObject);
+		RenderState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferObject);
+
+		IRenderDevice::Get().GenBuffers(1, &m_VertexBufferObject);
+		RenderState::BindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
+
+		#define BUFFER_OFFSET(i) ((char*)0 + (i))
+
+		// Position attribute
+		IRenderDevice::Get().EnableVertexAttribArray(0);
+		IRenderDevice::Get().VertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeVPCT, BUFFER_OFFSET(sizeFloat * 0));
+		// Color attribute
+		IRenderDevice::Get().EnableVertexAttribArray(1);
+		IRenderDevice::Get().VertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeVPCT, BUFFER_OFFSET(sizeFloat * 2));
+		// Texcoord attribute
+		IRenderDevice::Get().EnableVertexAttribArray(2);
+		IRenderDevice::Get().VertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeVPCT, BUFFER_OFFSET(sizeFloat * 6));
+
+		#undef BUFFER_OFFSET
+
+		RenderState::BindVertexArray(0);
+		RenderState::BindBuffer(GL_ARRAY_BUFFER, 0);
+
+		m_IsDirty = false;
+		m_Groups.clear();
+
+		return true;
+	}
+
+	bool StaticSpriteLayer::Finalize()
+	{
+		RenderState::ForgetVertexArray(m_VertexArrayObject);
+		RenderState::ForgetBuffer(m_VertexBufferObject);
+		RenderState::ForgetBuffer(m_IndexBufferObject);
+
+		IRenderDevice::Get().DeleteVertexArrays(1, &m_VertexArrayObject);
+		IRenderDevice::Get().DeleteBuffers(1, &m_VertexBufferObject);
+		IRenderDevice::Get().DeleteBuffers(1, &m_IndexBufferObject);
+
+		m_VertexArrayObject = 0;
+		m_VertexBufferObject = 0;
+		m_IndexBufferObject = 0;
+
+		m_Groups.clear();
+
+		return true;
+	}
+
+	SpriteRecorder& StaticSpriteLayer::Edit()
+	{
+		m_IsDirty = true;
+
+		return m_Recorder;
+	}
+
+	void StaticSpriteLayer::Clear()
+	{
+		m_Recorder.Clear();
+		m_IsDirty = true;
+	}
+
+	bool StaticSpriteLayer::Draw(Effect& p_Effect, const Camera2D& p_Camera, BlendMode p_BlendMode, RasterizerState p_RasterizerState)
+	{
+		m_FlushCount = 0;
+
+		if (m_VertexArrayObject == 0)
+		{
+			SDL_Log("[StaticSpriteLayer::Draw] The layer must be initialized first.");
+			return false;
+		}
+
+		if (m_IsDirty && !Rebuild())
+			return false;
+
+		if (m_Groups.empty())
+			return true;
+
+		// Uniforms apply to the bound program, so bind it first.
+		p_Effect.Use();
+		p_Effect.SetProjection(p_Camera.GetProjectionMatrix());
+		p_Effect.SetModelView(p_Camera.GetModelViewMatrix());
+
+		switch (p_BlendMode)
+		{
+			case BlendMode::None:
+				RenderState::SetBlend(false);
+				break;
+			case BlendMode::Premultiplied:
+				RenderState::SetBlend(true, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+				break;
+			case BlendMode::AlphaBlended:
+				RenderState::SetBlend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+				break;
+			case BlendMode::Additive:
+				RenderState::SetBlend(true, GL_SRC_ALPHA, GL_ONE);
+				break;
+		}
+
+		switch (p_RasterizerState)
+		{
+			case RasterizerState::None:
+				RenderState::SetCulling(false);
+				break;
+			case RasterizerState::CullClockwise:
+				RenderState::SetCulling(true, GL_FRONT);
+				break;
+			case RasterizerState::CullCounterClockwise:
+				RenderState::SetCulling(true, GL_BACK);
+				break;
+		}
+
+		#define BUFFER_OFFSET(i) ((char*)0 + (i))
+
+		// One draw per texture over the baked buffers.
+		RenderState::BindVertexArray(m_VertexArrayObject);
+		for (const StaticSpriteGroup& group : m_Groups)
+		{
+			RenderState::BindTexture(0, group.TextureID);
+			IRenderDevice::Get().DrawElements(GL_TRIANGLES, group.IndexCount, GL_UNSIGNED_INT, BUFFER_OFFSET(group.FirstIndex * sizeof(GLuint)));
+
+			m_FlushCount++;
+		}
+
+		#undef BUFFER_OFFSET
+
+		return true;
+	}
+
+	bool StaticSpriteLayer::Rebuild()
+	{
+		int itemCount = m_Recorder.GetItemCount();
+
+		// Group items by texture, keeping recorded order within each texture.
+		std::vector<int> order(itemCount);
+		for (int i = 0; i < itemCount; ++i)
+		{
+			order[i] = i;
+		}
+
+		std::stable_sort(order.begin(), order.end(), [this](int p_A, int p_B)
+		{
+			return m_Recorder.GetItem(p_A).TextureID < m_Recorder.GetItem(p_B).TextureID;
+		});
+
+		std::vector<VertexPositionColorTexture> vertices(itemCount * 4);
+		std::vector<GLuint> indices(itemCount * 6);
+
+		m_Groups.clear();
+
+		for (int i = 0; i < itemCount; ++i)
+		{
+			const SpriteBatchItem& item = m_Recorder.GetItem(order[i]);
+
+			if (m_Groups.empty() || m_Groups.back().TextureID != item.TextureID)
+			{
+				StaticSpriteGroup group;
+				group.TextureID = item.TextureID;
+				group.FirstIndex = i * 6;
+				group.IndexCount = 0;
+
+				m_Groups.push_back(group);
+			}
+
+			m_Groups.back().IndexCount += 6;
+
+			vertices[i * 4 + 0] = item.VertexA;
+			vertices[i * 4 + 1] = item.VertexB;
+			vertices[i * 4 + 2] = item.VertexC;
+			vertices[i * 4 + 3] = item.VertexD;
+
+			// Each quad is drawn as 0-1-2 / 2-1-3.
+			GLuint base = i * 4;
+			indices[i * 6 + 0] = base + 0;
+			indices[i * 6 + 1] = base + 1;
+			indices[i * 6 + 2] = base + 2;
+			indices[i * 6 + 3] = base + 2;
+			indices[i * 6 + 4] = base + 1;
+			indices[i * 6 + 5] = base + 3;
+		}
+
+		// Replace the buffers' contents in one upload each.
+		RenderState::BindVertexArray(m_VertexArrayObject);
+		RenderState::BindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
+		IRenderDevice::Get().BufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(VertexPositionColorTexture), vertices.empty() ? nullptr : &vertices.front(), GL_STATIC_DRAW);
+		RenderState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferObject);
+		IRenderDevice::Get().BufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.empty() ? nullptr : &indices.front(), GL_STATIC_DRAW);
+
+		m_IsDirty = false;
+
+		return true;
+	}
+}
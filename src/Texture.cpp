@@ -7,23 +7,53 @@
 	#include <SDL2/SDL_image.h>
 #endif
 // SAGE Includes
+#include <SAGE/IRenderDevice.hpp>
 #include <SAGE/Math.hpp>
+#include <SAGE/Profiler.hpp>
+#include <SAGE/RenderState.hpp>
 #include <SAGE/Texture.hpp>
+#include <SAGE/TextureStreamer.hpp>
 
 namespace SAGE
 {
+	std::atomic<Uint64> Texture::sCPUByteCount(0);
+	std::atomic<Uint64> Texture::sGPUByteCount(0);
+
 	Texture::Texture()
 	{
 		m_ID = -1;
 		m_IsLoaded = false;
+		m_RetainPixels = false;
+		m_DecodedSurface = nullptr;
+		m_CPUByteCount = 0;
+		m_GPUByteCount = 0;
+		m_Streamer = nullptr;
 	}
 
 	Texture::~Texture()
 	{
+		if (m_Streamer != nullptr)
+		{
+			m_Streamer->Cancel(*this);
+		}
+
 		if (m_IsLoaded)
 		{
 			Unload();
 		}
+
+		FreeDecodedSurface();
+		AccountMemory(0, 0);
+	}
+
+	Uint64 Texture::GetCPUByteCount()
+	{
+		return sCPUByteCount.load();
+	}
+
+	Uint64 Texture::GetGPUByteCount()
+	{
+		return sGPUByteCount.load();
 	}
 
 	unsigned int Texture::GetID() const
@@ -56,6 +86,16 @@ namespace SAGE
 		return m_Wrapping;
 	}
 
+	bool Texture::IsStreaming() const
+	{
+		return m_Streamer != nullptr;
+	}
+
+	bool Texture::IsRetainingPixels() const
+	{
+		return m_RetainPixels;
+	}
+
 	bool Texture::GetPixelColor(unsigned int p_X, unsigned int p_Y, Color& p_Color)
 	{
 		// Check if within bounds.
@@ -65,11 +105,28 @@ namespace SAGE
 			return false;
 		}
 
-		p_Color = m_Colors[p_X + p_Y * m_Width];
+		if (m_Pixels.empty())
+		{
+			SDL_Log("[Texture::GetPixelColor] Pixels were not retained for this texture.");
+			return false;
+		}
+
+		p_Color.SetFromComposite(m_Pixels[p_X + p_Y * m_Width]);
 
 		return true;
 	}
 
+	void Texture::SetRetainPixels(bool p_Retain)
+	{
+		m_RetainPixels = p_Retain;
+
+		if (!m_RetainPixels && !m_Pixels.empty())
+		{
+			AccountMemory(m_CPUByteCount - m_Pixels.size() * sizeof(Uint32), m_GPUByteCount);
+			std::vector<Uint32>().swap(m_Pixels);
+		}
+	}
+
 	bool Texture::FromPixelColors(unsigned int p_Width, unsigned int p_Height, std::vector<Color> p_Colors, Interpolation p_Interpolation, Wrapping p_Wrapping)
 	{
 		// Check if already loaded.
@@ -86,39 +143,45 @@ namespace SAGE
 		m_Interpolation = p_Interpolation;
 		m_Wrapping = p_Wrapping;
 
-		// Copy colors to cpmposite pixels.
+		// Copy colors to composite pixels.
+		std::vector<Uint32> pixels;
+		pixels.reserve(p_Colors.size());
 		for (const auto& color : p_Colors)
 		{
-			m_Colors.push_back(color);
-
-			Uint32 composite = color.GetAsComposite();
-			m_Pixels.push_back(composite);
-
-			/*
-			SDL_Log("Added Composite Color: { R: %d, G: %d, B: %d, A: %d } = %u",
-				color.GetRedAsByte(),
-				color.GetGreenAsByte(),
-				color.GetBlueAsByte(),
-				color.GetAlphaAsByte(),
-				composite);
-			*/
+			pixels.push_back(color.GetAsComposite());
 		}
 
 		// Create the texture.
-		if (!CreateFromPixelData(static_cast<void*>(&m_Pixels.front())))
+		if (!CreateFromPixelData(static_cast<void*>(&pixels.front())))
 		{
 			return false;
 		}
 
+		// Keep the composite pixels only if asked to.
+		if (m_RetainPixels)
+		{
+			m_Pixels.swap(pixels);
+			AccountMemory(m_Pixels.size() * sizeof(Uint32), m_GPUByteCount);
+		}
+
 		return (m_IsLoaded = true);
 	}
 
 	bool Texture::Load(const std::string& p_Filename, Interpolation p_Interpolation, Wrapping p_Wrapping)
 	{
+		SAGE_PROFILE_ZONE("Texture::Load");
+
+		return Decode(p_Filename, p_Interpolation, p_Wrapping) && Upload();
+	}
+
+	bool Texture::Decode(const std::string& p_Filename, Interpolation p_Interpolation, Wrapping p_Wrapping)
+	{
+		SAGE_PROFILE_ZONE("Texture::Decode");
+
 		// Check if already loaded.
-		if (m_IsLoaded)
+		if (m_IsLoaded || m_DecodedSurface != nullptr)
 		{
-			SDL_Log("[Texture::Load] Texture is already loaded.");
+			SDL_Log("[Texture::Decode] Texture is already loaded.");
 			return false;
 		}
 
@@ -126,7 +189,7 @@ namespace SAGE
 		SDL_Surface* surface = IMG_Load(p_Filename.c_str());
 		if (surface == nullptr)
 		{
-			SDL_Log("[Texture::Load] Failed to load image file \"%s\": %s", p_Filename.c_str(), SDL_GetError());
+			SDL_Log("[Texture::Decode] Failed to load image file \"%s\": %s", p_Filename.c_str(), SDL_GetError());
 			return false;
 		}
 
@@ -137,35 +200,79 @@ namespace SAGE
 		m_Interpolation = p_Interpolation;
 		m_Wrapping = p_Wrapping;
 
-		// Gather pixel colors.
-		Uint32 pixel;
-		Color color;
-		for (int y = 0; y < m_Height; ++y)
+		// Gather pixels, if they are to be retained.
+		if (m_RetainPixels)
 		{
-			for (int x = 0; x < m_Width; ++x)
+			m_Pixels.reserve(m_Width * m_Height);
+
+			Uint32 pixel;
+			for (unsigned int y = 0; y < m_Height; ++y)
 			{
-				if (ReadColorDataFromSurface(surface, x, y, pixel, color))
+				for (unsigned int x = 0; x < m_Width; ++x)
 				{
-					m_Pixels.push_back(pixel);
-					m_Colors.push_back(color);
+					if (ReadPixelFromSurface(surface, x, y, pixel))
+					{
+						m_Pixels.push_back(pixel);
+					}
 				}
 			}
 		}
 
-		// Create the texture.
-		if (!CreateFromPixelData(surface->pixels))
+		// Keep the surface until Upload.
+		m_DecodedSurface = surface;
+		AccountMemory(m_Pixels.size() * sizeof(Uint32) + surface->pitch * surface->h, m_GPUByteCount);
+
+		return true;
+	}
+
+	bool Texture::Upload()
+	{
+		SAGE_PROFILE_ZONE("Texture::Upload");
+
+		if (m_DecodedSurface == nullptr)
 		{
+			SDL_Log("[Texture::Upload] Texture must be decoded first.");
 			return false;
 		}
 
-		// Free the loaded surface.
-		SDL_FreeSurface(surface);
+		// Create the texture.
+		bool created = CreateFromPixelData(m_DecodedSurface->pixels);
+
+		// Free the decoded surface.
+		FreeDecodedSurface();
+
+		if (!created)
+		{
+			std::vector<Uint32>().swap(m_Pixels);
+			AccountMemory(0, 0);
+
+			return false;
+		}
 
 		return (m_IsLoaded = true);
 	}
 
+	bool Texture::LoadAsync(TextureStreamer& p_Streamer, const std::string& p_Filename, Interpolation p_Interpolation, Wrapping p_Wrapping)
+	{
+		// Check if already loaded.
+		if (m_IsLoaded || m_DecodedSurface != nullptr || m_Streamer != nullptr)
+		{
+			SDL_Log("[Texture::LoadAsync] Texture is already loaded.");
+			return false;
+		}
+
+		return p_Streamer.Request(*this, p_Filename, p_Interpolation, p_Wrapping);
+	}
+
 	bool Texture::Unload()
 	{
+		// A texture still streaming has nothing of its own to delete yet.
+		if (m_Streamer != nullptr)
+		{
+			m_Streamer->Cancel(*this);
+			return true;
+		}
+
 		if (!m_IsLoaded)
 		{
 			SDL_Log("[Texture::Unload] Texture already unloaded. Doing nothing.");
@@ -175,11 +282,12 @@ namespace SAGE
 			// Delete the texture.
 			if (m_ID != -1)
 			{
-				glDeleteTextures(1, &m_ID);
+				RenderState::ForgetTexture(m_ID);
+				IRenderDevice::Get().DeleteTextures(1, &m_ID);
 			}
 
-			m_Pixels.clear();
-			m_Colors.clear();
+			std::vector<Uint32>().swap(m_Pixels);
+			AccountMemory(0, 0);
 
 			m_IsLoaded = false;
 		}
@@ -215,20 +323,20 @@ namespace SAGE
 		}
 
 		// Generate and create the texture.
-		glGenTextures(1, &m_ID);
-		glBindTexture(GL_TEXTURE_2D, m_ID);
-		glTexImage2D(GL_TEXTURE_2D, 0, format, m_Width, m_Height, 0, format, GL_UNSIGNED_BYTE, p_PixelData);
+		IRenderDevice::Get().GenTextures(1, &m_ID);
+		RenderState::BindTexture(0, m_ID);
+		IRenderDevice::Get().TexImage2D(GL_TEXTURE_2D, 0, format, m_Width, m_Height, 0, format, GL_UNSIGNED_BYTE, p_PixelData);
 
 		// Set scaling interpolation.
 		switch (m_Interpolation)
 		{
 			case Interpolation::Nearest:
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+				IRenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+				IRenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 				break;
 			case Interpolation::Linear:
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+				IRenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				IRenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 				break;
 		}
 
@@ -236,67 +344,82 @@ namespace SAGE
 		switch (m_Wrapping)
 		{
 			case Wrapping::Repeat:
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+				IRenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+				IRenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 				break;
 			case Wrapping::RepeatMirrored:
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
+				IRenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
+				IRenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
 				break;
 			case Wrapping::ClampToEdge:
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+				IRenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+				IRenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 				break;
 			case Wrapping::ClampToBorder:
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+				IRenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+				IRenderDevice::Get().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
 				static float color[] = { 0.0f, 0.0f, 0.0f, 1.0f };
-				glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, color);
+				IRenderDevice::Get().TexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, color);
 				break;
 		}
 
 		// Unbind the texture.
-		glBindTexture(GL_TEXTURE_2D, 0);
+		RenderState::BindTexture(0, 0);
+
+		// Mipmaps are never generated, so the storage is just the base level.
+		AccountMemory(m_CPUByteCount, static_cast<Uint64>(m_Width) * m_Height * m_BytesPerPixel);
 
 		return true;
 	}
 
-	bool Texture::ReadColorDataFromSurface(SDL_Surface* p_Surface, unsigned int p_X, unsigned int p_Y, Uint32& p_Pixel, Color& p_Color)
+	bool Texture::ReadPixelFromSurface(SDL_Surface* p_Surface, unsigned int p_X, unsigned int p_Y, Uint32& p_Pixel)
 	{
 		// Check if within bounds.
 		if (p_X >= m_Width || p_Y >= m_Height)
 		{
-			SDL_Log("[Texture::ReadColorDataFromSurface] Coordinates are out of texture bounds.");
+			SDL_Log("[Texture::ReadPixelFromSurface] Coordinates are out of texture bounds.");
 			return false;
 		}
 
 		Uint8* pointer = (Uint8*)p_Surface->pixels + p_Y * p_Surface->pitch + p_X * m_BytesPerPixel;
 
+		// Surfaces are uploaded as bytes in RGB(A) order, so they're read the same way into the RGBA8888 composite Color uses.
 		switch (m_BytesPerPixel)
 		{
-			case 1:
-				p_Pixel = *pointer;
-				break;
-			case 2:
-				p_Pixel = *(Uint16*)pointer;
-				break;
 			case 3:
-#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-					p_Pixel = pointer[0] << 16 | pointer[1] << 8 | pointer[2];
-#else
-					p_Pixel = pointer[0] | pointer[1] << 8 | pointer[2] << 16;
-#endif
+				p_Pixel = (Uint32)pointer[0] << 24 | (Uint32)pointer[1] << 16 | (Uint32)pointer[2] << 8 | 0xFF;
 				break;
 			case 4:
-				p_Pixel = *(Uint32*)pointer;
+				p_Pixel = (Uint32)pointer[0] << 24 | (Uint32)pointer[1] << 16 | (Uint32)pointer[2] << 8 | (Uint32)pointer[3];
 				break;
 			default:
-				SDL_LogWarn(SDL_LOG_PRIORITY_WARN, "[Texture::ReadColorDataFromSurface] Pixel data has unknown color format.");
+				SDL_LogWarn(SDL_LOG_PRIORITY_WARN, "[Texture::ReadPixelFromSurface] Pixel data does not use true color.");
 				return false;
 		}
 
-		p_Color.SetFromComposite(p_Pixel);
+		return true;
+	}
+
+	void Texture::FreeDecodedSurface()
+	{
+		if (m_DecodedSurface == nullptr)
+			return;
 
-		return false;
+		AccountMemory(m_CPUByteCount - m_DecodedSurface->pitch * m_DecodedSurface->h, m_GPUByteCount);
+
+		SDL_FreeSurface(m_DecodedSurface);
+		m_DecodedSurface = nullptr;
+	}
+
+	void Texture::AccountMemory(Uint64 p_CPUBytes, Uint64 p_GPUBytes)
+	{
+		// Totals are shared with textures decoding on other threads.
+		sCPUByteCount -= m_CPUByteCount;
+		sCPUByteCount += p_CPUBytes;
+		sGPUByteCount -= m_GPUByteCount;
+		sGPUByteCount += p_GPUBytes;
+
+		m_CPUByteCount = p_CPUBytes;
+		m_GPUByteCount = p_GPUBytes;
 	}
 }
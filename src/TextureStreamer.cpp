@@ -0,0 +1,355 @@
+// TextureStreamer.cpp
+
+// SAGE Includes
+#include <SAGE/IRenderDevice.hpp>
+#include <SAGE/Profiler.hpp>
+#include <SAGE/RenderState.hpp>
+#include <SAGE/TextureStreamer.hpp>
+// SDL Includes
+#include <SDL2/SDL.h>
+// STL Includes
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace SAGE
+{
+	const int TextureStreamerOptions::DefaultBytesPerFrame = 4 * 1024 * 1024;
+	const Color TextureStreamerOptions::DefaultPlaceholderColor = Color::TransparentBlack;
+
+	const TextureStreamerOptions TextureStreamerOptions::DefaultOptions;
+
+	TextureStreamer::TextureStreamer()
+	{
+		m_JobSystem = nullptr;
+		m_BytesPerFrame = TextureStreamerOptions::DefaultBytesPerFrame;
+		m_UploadedByteCount = 0;
+		m_PixelBuffer = 0;
+	}
+
+	TextureStreamer::~TextureStreamer()
+	{
+		Finalize();
+	}
+
+	unsigned int TextureStreamer::GetPlaceholderID() const
+	{
+		return m_Placeholder.GetID();
+	}
+
+	int TextureStreamer::GetBytesPerFrame() const
+	{
+		return m_BytesPerFrame;
+	}
+
+	int TextureStreamer::GetPendingCount() const
+	{
+		return (int)m_Requests.size();
+	}
+
+	int TextureStreamer::GetUploadedByteCount() const
+	{
+		return m_UploadedByteCount;
+	}
+
+	bool TextureStreamer::Initialize(JobSystem* p_JobSystem, const TextureStreamerOptions& p_Options)
+	{
+		if (m_PixelBuffer != 0)
+		{
+			SDL_Log("[TextureStreamer::Initialize] The texture streamer is already initialized.");
+			return false;
+		}
+
+		if (p_JobSystem == nullptr)
+		{
+			SDL_Log("[TextureStreamer::Initialize] A job system is required for decoding.");
+			return false;
+		}
+
+		std::vector<Color> pixels = { p_Options.PlaceholderColor };
+		if (!m_Placeholder.FromPixelColors(1, 1, pixels))
+		{
+			SDL_Log("[TextureStreamer::Initialize] Failed to create the placeholder texture.");
+			return false;
+		}
+
+		IRenderDevice::Get().GenBuffers(1, &m_PixelBuffer);
+
+		m_JobSystem = p_JobSystem;
+		SetBytesPerFrame(p_Options.BytesPerFrame);
+
+		return true;
+	}
+
+	bool TextureStreamer::Finalize()
+	{
+		if (m_PixelBuffer == 0)
+			return true;
+
+		// Workers may still be decoding into requests, so let them finish before anything is freed.
+		for (std::unique_ptr<StreamRequest>& request : m_Requests)
+		{
+			m_JobSystem->Wait(request->Decoded);
+
+			if (request->Target != nullptr)
+			{
+				request->Target->m_Streamer = nullptr;
+				request->Target->m_ID = -1;
+			}
+
+			Discard(*request);
+		}
+
+		m_Requests.clear();
+		m_Chunks.clear();
+
+		IRenderDevice::Get().DeleteBuffers(1, &m_PixelBuffer);
+		m_PixelBuffer = 0;
+
+		m_Placeholder.Unload();
+
+		return true;
+	}
+
+	void TextureStreamer::SetBytesPerFrame(int p_Bytes)
+	{
+		m_BytesPerFrame = std::max(1, p_Bytes);
+	}
+
+	bool TextureStreamer::Request(Texture& p_Texture, const std::string& p_Filename, Interpolation p_Interpolation, Wrapping p_Wrapping)
+	{
+		if (m_PixelBuffer == 0)
+		{
+			SDL_Log("[TextureStreamer::Request] The texture streamer must be initialized first.");
+			return false;
+		}
+
+		std::unique_ptr<StreamRequest> request(new StreamRequest());
+		request->Target = &p_Texture;
+		request->Filename = p_Filename;
+		request->Filter = p_Interpolation;
+		request->Wrap = p_Wrapping;
+		request->Staging.m_RetainPixels = p_Texture.m_RetainPixels;
+		request->Failed = false;
+		request->Allocated = false;
+		request->RowsUploaded = 0;
+
+		// The texture draws as the placeholder, at no size, until the real one is ready.
+		p_Texture.m_Streamer = this;
+		p_Texture.m_ID = m_Placeholder.GetID();
+		p_Texture.m_Width = 0;
+		p_Texture.m_Height = 0;
+		p_Texture.m_BytesPerPixel = 0;
+		p_Texture.m_Interpolation = p_Interpolation;
+		p_Texture.m_Wrapping = p_Wrapping;
+
+		// Requests are held by pointer, so the worker's one stays valid while the list changes.
+		StreamRequest* decoding = request.get();
+		m_JobSystem->ScheduleBackground([decoding]()
+		{
+			decoding->Failed = !decoding->Staging.Decode(decoding->Filename, decoding->Filter, decoding->Wrap);
+		}, &decoding->Decoded);
+
+		m_Requests.push_back(std::move(request));
+
+		return true;
+	}
+
+	void TextureStreamer::Cancel(Texture& p_Texture)
+	{
+		// The request itself is dropped by Update once its decode has finished.
+		for (std::unique_ptr<StreamRequest>& request : m_Requests)
+		{
+			if (request->Target == &p_Texture)
+			{
+				request->Target = nullptr;
+				break;
+			}
+		}
+
+		p_Texture.m_Streamer = nullptr;
+		p_Texture.m_ID = -1;
+		p_Texture.m_Width = 0;
+		p_Texture.m_Height = 0;
+	}
+
+	void TextureStreamer::Update()
+	{
+		SAGE_PROFILE_ZONE("TextureStreamer::Update");
+
+		m_UploadedByteCount = 0;
+		m_Chunks.clear();
+
+		// Plan this frame's rows in request order until the budget is spent.
+		int size = 0;
+		for (size_t i = 0; i < m_Requests.size(); ++i)
+		{
+			StreamRequest& request = *m_Requests[i];
+			if (!request.Decoded.IsDone() || request.Target == nullptr)
+				continue;
+
+			if (request.Failed || (!request.Allocated && !Allocate(request)))
+				continue;
+
+			SDL_Surface* surface = request.Staging.m_DecodedSurface;
+			int remaining = m_BytesPerFrame - size;
+			if (remaining < surface->pitch && size > 0)
+				break;
+
+			StreamChunk chunk;
+			chunk.Request = &request;
+			chunk.FirstRow = request.RowsUploaded;
+			chunk.RowCount = std::min(surface->h - request.RowsUploaded, std::max(1, remaining / surface->pitch));
+			chunk.Offset = size;
+			m_Chunks.push_back(chunk);
+
+			request.RowsUploaded += chunk.RowCount;
+			size += chunk.RowCount * surface->pitch;
+
+			if (size >= m_BytesPerFrame)
+				break;
+		}
+
+		if (!m_Chunks.empty())
+			UploadChunks(size);
+
+		// Hand finished textures over and drop cancelled or failed requests.
+		for (size_t i = 0; i < m_Requests.size();)
+		{
+			StreamRequest& request = *m_Requests[i];
+			bool done = false;
+
+			if (request.Decoded.IsDone())
+			{
+				if (request.Target == nullptr)
+				{
+					Discard(request);
+					done = true;
+				}
+				else if (request.Failed)
+				{
+					SDL_Log("[TextureStreamer::Update] Failed to stream \"%s\".", request.Filename.c_str());
+					request.Target->m_Streamer = nullptr;
+					request.Target->m_ID = -1;
+					Discard(request);
+					done = true;
+				}
+				else if (request.Allocated && request.RowsUploaded == (int)request.Staging.m_Height)
+				{
+					Complete(request);
+					done = true;
+				}
+			}
+
+			if (done)
+				m_Requests.erase(m_Requests.begin() + i);
+			else
+				++i;
+		}
+	}
+
+	bool TextureStreamer::Allocate(StreamRequest& p_Request)
+	{
+		// Storage is created empty and filled by the chunk uploads; the unpack buffer must not be bound here.
+		if (!p_Request.Staging.CreateFromPixelData(nullptr))
+		{
+			p_Request.Failed = true;
+			return false;
+		}
+
+		p_Request.Allocated = true;
+
+		// Sprites can be laid out at the right size while the placeholder is still showing.
+		Texture& target = *p_Request.Target;
+		target.m_Width = p_Request.Staging.m_Width;
+		target.m_Height = p_Request.Staging.m_Height;
+		target.m_BytesPerPixel = p_Request.Staging.m_BytesPerPixel;
+
+		return true;
+	}
+
+	void TextureStreamer::UploadChunks(int p_Size)
+	{
+		// Orphaning the buffer lets the driver hand back fresh storage instead of waiting on last frame's copies.
+		RenderState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PixelBuffer);
+		IRenderDevice::Get().BufferData(GL_PIXEL_UNPACK_BUFFER, p_Size, nullptr, GL_STREAM_DRAW);
+
+		unsigned char* mapped = static_cast<unsigned char*>(IRenderDevice::Get().MapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, p_Size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+
+		if (mapped != nullptr)
+		{
+			for (const StreamChunk& chunk : m_Chunks)
+			{
+				SDL_Surface* surface = chunk.Request->Staging.m_DecodedSurface;
+				const unsigned char* rows = static_cast<const unsigned char*>(surface->pixels) + chunk.FirstRow * surface->pitch;
+
+				std::memcpy(mapped + chunk.Offset, rows, chunk.RowCount * surface->pitch);
+			}
+
+			IRenderDevice::Get().UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		}
+		else
+		{
+			// Without a mapping, upload straight from the decoded surfaces instead.
+			RenderState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		}
+
+		// Rows are copied at the surface pitch, which matches GL's default four-byte unpack alignment.
+		for (const StreamChunk& chunk : m_Chunks)
+		{
+			Texture& staging = chunk.Request->Staging;
+			SDL_Surface* surface = staging.m_DecodedSurface;
+			GLenum format = staging.m_BytesPerPixel == 4 ? GL_RGBA : GL_RGB;
+
+			const void* pixels = nullptr;
+			if (mapped != nullptr)
+				pixels = reinterpret_cast<const void*>(static_cast<uintptr_t>(chunk.Offset));
+			else
+				pixels = static_cast<const unsigned char*>(surface->pixels) + chunk.FirstRow * surface->pitch;
+
+			RenderState::BindTexture(0, staging.m_ID);
+			IRenderDevice::Get().TexSubImage2D(GL_TEXTURE_2D, 0, 0, chunk.FirstRow, staging.m_Width, chunk.RowCount, format, GL_UNSIGNED_BYTE, pixels);
+		}
+
+		RenderState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		RenderState::BindTexture(0, 0);
+
+		m_UploadedByteCount = p_Size;
+	}
+
+	void TextureStreamer::Complete(StreamRequest& p_Request)
+	{
+		Texture& staging = p_Request.Staging;
+		Texture& target = *p_Request.Target;
+
+		// The target takes over the GL texture and any retained pixels; the staging texture keeps nothing.
+		target.m_ID = staging.m_ID;
+		target.m_Pixels.swap(staging.m_Pixels);
+		target.AccountMemory(target.m_Pixels.size() * sizeof(Uint32), staging.m_GPUByteCount);
+		target.m_IsLoaded = true;
+		target.m_Streamer = nullptr;
+
+		staging.m_ID = -1;
+		p_Request.Allocated = false;
+
+		Discard(p_Request);
+	}
+
+	void TextureStreamer::Discard(StreamRequest& p_Request)
+	{
+		Texture& staging = p_Request.Staging;
+
+		if (p_Request.Allocated)
+		{
+			RenderState::ForgetTexture(staging.m_ID);
+			IRenderDevice::Get().DeleteTextures(1, &staging.m_ID);
+			staging.m_ID = -1;
+			p_Request.Allocated = false;
+		}
+
+		staging.FreeDecodedSurface();
+
+		std::vector<Uint32>().swap(staging.m_Pixels);
+		staging.AccountMemory(0, 0);
+	}
+}
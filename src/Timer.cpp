@@ -7,6 +7,10 @@ namespace SAGE
 {
 	Timer::Timer()
 	{
+		m_StartCount = 0;
+		m_LastCount = 0;
+		m_PausedCount = 0;
+
 		Stop();
 	}
 
@@ -15,44 +19,48 @@ namespace SAGE
 	}
 
 	float Timer::GetDeltaTime()
+	{
+		return (float)(GetDeltaNanoseconds() / 1000000000.0);
+	}
+
+	Uint64 Timer::GetDeltaNanoseconds()
 	{
 		if (!m_Started || m_Paused)
-			return 0.0f;
+			return 0;
 
-		Uint32 current = SDL_GetTicks();
-		Uint32 difference = current - m_LastTicks;
-		m_LastTicks = current;
+		Uint64 current = SDL_GetPerformanceCounter();
+		Uint64 difference = current - m_LastCount;
+		m_LastCount = current;
 
-		return (float)(difference / 1000.0f);
+		return GetNanoseconds(difference);
 	}
 
 	float Timer::GetElapsedTime() const
 	{
-		if (!m_Started)
-			return 0.0f;
-
-		if (m_Paused)
-			return (float)m_PausedTicks;
-		else
-			return (float)((SDL_GetTicks() - m_StartTicks) / 1000.0f);
+		return (float)(GetElapsedNanoseconds() / 1000000000.0);
 	}
 
-	int Timer::GetTicks() const
+	Uint64 Timer::GetElapsedNanoseconds() const
 	{
 		if (!m_Started)
 			return 0;
 
 		if (m_Paused)
-			return m_PausedTicks;
+			return GetNanoseconds(m_PausedCount);
 		else
-			return (SDL_GetTicks() - m_StartTicks);
+			return GetNanoseconds(SDL_GetPerformanceCounter() - m_StartCount);
+	}
+
+	int Timer::GetTicks() const
+	{
+		return (int)(GetElapsedNanoseconds() / 1000000);
 	}
 
 	void Timer::Start()
 	{
-		m_StartTicks = SDL_GetTicks();
-		m_LastTicks = m_StartTicks;
-		m_PausedTicks = 0;
+		m_StartCount = SDL_GetPerformanceCounter();
+		m_LastCount = m_StartCount;
+		m_PausedCount = 0;
 		m_Started = true;
 		m_Paused = false;
 	}
@@ -67,7 +75,7 @@ namespace SAGE
 	{
 		if (m_Started && !m_Paused)
 		{
-			m_PausedTicks = SDL_GetTicks() - m_StartTicks;
+			m_PausedCount = SDL_GetPerformanceCounter() - m_StartCount;
 			m_Paused = true;
 		}
 	}
@@ -76,9 +84,21 @@ namespace SAGE
 	{
 		if (m_Paused)
 		{
-			m_StartTicks = SDL_GetTicks() - m_PausedTicks;
-			m_PausedTicks = 0;
+			Uint64 current = SDL_GetPerformanceCounter();
+
+			// Time spent paused is excluded from both elapsed and delta time.
+			m_StartCount = current - m_PausedCount;
+			m_LastCount = current;
+			m_PausedCount = 0;
 			m_Paused = false;
 		}
 	}
+
+	Uint64 Timer::GetNanoseconds(Uint64 p_Counts)
+	{
+		static const Uint64 frequency = SDL_GetPerformanceFrequency();
+
+		// Split the conversion so large counts don't overflow.
+		return (p_Counts / frequency) * 1000000000 + (p_Counts % frequency) * 1000000000 / frequency;
+	}
 }
@@ -0,0 +1,61 @@
+// UnitCircle.cpp
+
+// SAGE Includes
+#include <SAGE/Math.hpp>
+#include <SAGE/UnitCircle.hpp>
+
+namespace SAGE
+{
+	UnitCircle::UnitCircle(int p_SegmentCount)
+	{
+		m_SegmentCount = 0;
+
+		SetSegmentCount(p_SegmentCount);
+	}
+
+	UnitCircle::~UnitCircle()
+	{
+	}
+
+	int UnitCircle::GetSegmentCount() const
+	{
+		return m_SegmentCount;
+	}
+
+	const Vector2* UnitCircle::GetPoints() const
+	{
+		return &m_Points.front();
+	}
+
+	void UnitCircle::SetSegmentCount(int p_SegmentCount)
+	{
+		if (p_SegmentCount < 3)
+			p_SegmentCount = 3;
+
+		if (p_SegmentCount == m_SegmentCount)
+			return;
+
+		m_SegmentCount = p_SegmentCount;
+		m_Points.resize(m_SegmentCount + 1);
+
+		float step = Math::TwoPi / static_cast<float>(m_SegmentCount);
+
+		for (int i = 0; i < m_SegmentCount; ++i)
+		{
+			float angle = static_cast<float>(i) * step;
+
+			m_Points[i].X = cosf(angle);
+			m_Points[i].Y = sinf(angle);
+		}
+
+		m_Points[m_SegmentCount] = m_Points[0];
+	}
+
+	const UnitCircle& UnitCircle::GetDefault()
+	{
+		// Function-local statics are initialized once, even with several threads recording.
+		static const UnitCircle sDefault;
+
+		return sDefault;
+	}
+}
@@ -7,6 +7,8 @@
 	#include <GL/glew.h>
 #endif
 // SAGE Includes
+#include <SAGE/IRenderDevice.hpp>
+#include <SAGE/RenderState.hpp>
 #include <SAGE/Window.hpp>
 // JsonCpp Includes
 #include <json/json.h>
@@ -125,6 +127,11 @@ namespace SAGE
 		return m_Window;
 	}
 
+	SDL_GLContext Window::GetContext() const
+	{
+		return m_Context;
+	}
+
 	bool Window::Initialize(const WindowOptions& p_Options)
 	{
 		if (m_IsInitialized)
@@ -150,7 +157,7 @@ namespace SAGE
 #endif
 
 		// Set viewport.
-		glViewport(0, 0, p_Options.Width, p_Options.Height);
+		IRenderDevice::Get().Viewport(0, 0, p_Options.Width, p_Options.Height);
 
 		// Create the window.
 		m_Window = SDL_CreateWindow(p_Options.Title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, p_Options.Width, p_Options.Height, flags);
@@ -175,9 +182,9 @@ namespace SAGE
 			return false;
 		}
 
-		// Set OpenGL properties.
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		// Set OpenGL properties. The new context starts with no known state.
+		RenderState::Reset();
+		RenderState::SetBlend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 		return (m_IsInitialized = true);
 	}
@@ -276,7 +283,7 @@ namespace SAGE
 	void Window::SetSize(int p_Width, int p_Height)
 	{
 		SDL_SetWindowSize(m_Window, p_Width, p_Height);
-		glViewport(0, 0, p_Width, p_Height);
+		IRenderDevice::Get().Viewport(0, 0, p_Width, p_Height);
 	}
 
 	void Window::SetIcon(const Surface& p_Surface)
@@ -286,7 +293,7 @@ namespace SAGE
 
 	void Window::SetClearColor(const Color& p_Color)
 	{
-		glClearColor(p_Color.GetRed(), p_Color.GetGreen(), p_Color.GetBlue(), p_Color.GetAlpha());
+		IRenderDevice::Get().ClearColor(p_Color.GetRed(), p_Color.GetGreen(), p_Color.GetBlue(), p_Color.GetAlpha());
 	}
 
 	bool Window::SetVerticalSync(bool p_Enabled)
@@ -335,7 +342,7 @@ namespace SAGE
 
 	void Window::Clear()
 	{
-		glClear(GL_COLOR_BUFFER_BIT);
+		IRenderDevice::Get().Clear(GL_COLOR_BUFFER_BIT);
 	}
 
 	void Window::Flip()